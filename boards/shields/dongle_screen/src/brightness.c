@@ -9,6 +9,20 @@
 #include <math.h>
 #include <stdlib.h>
 
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+#include "custom_status_screen.h"
+#endif
+
+#if CONFIG_DONGLE_SCREEN_FRAME_RATE_POLICY
+#include "frame_rate.h"
+#endif
+
+#if CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+#include <zephyr/pm/device.h>
+#include <zmk/display.h>
+#include <lvgl.h>
+#endif
+
 int random0to100()
 {
     return rand() % 101; // 0 to 100
@@ -209,6 +223,90 @@ struct fade_request_t
 
 #define FADE_QUEUE_SIZE 4
 
+#if CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+
+static const struct device *panel_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+static const struct device *panel_spi_dev = DEVICE_DT_GET(DT_NODELABEL(disp_spi));
+static bool panel_asleep = false;
+
+// The panel sits on the bus through the MIPI-DBI node, any child of the bus is another user
+// that still needs it, so the bus is only suspended when it carries nothing else
+#define PANEL_SPI_SHARED (DT_CHILD_NUM_STATUS_OKAY(DT_NODELABEL(disp_spi)) > 0)
+
+// Writes are dropped while the panel sleeps, so the whole screen is redrawn after waking up
+static void panel_redraw_cb(struct k_work *work)
+{
+    lv_obj_invalidate(lv_screen_active());
+}
+
+static K_WORK_DEFINE(panel_redraw_work, panel_redraw_cb);
+
+// Put the panel and its SPI bus to sleep once the backlight is dark
+static void panel_sleep(void)
+{
+    if (panel_asleep)
+    {
+        return;
+    }
+
+    int ret = pm_device_action_run(panel_dev, PM_DEVICE_ACTION_SUSPEND);
+    if (ret < 0 && ret != -EALREADY)
+    {
+        LOG_WRN("Failed to suspend the display (%d)", ret);
+        return;
+    }
+
+    if (!PANEL_SPI_SHARED)
+    {
+        ret = pm_device_action_run(panel_spi_dev, PM_DEVICE_ACTION_SUSPEND);
+        if (ret < 0 && ret != -EALREADY)
+        {
+            // Wake the panel again, so both stay in step and the next fade-out retries
+            LOG_WRN("Failed to suspend the display SPI (%d)", ret);
+            (void)pm_device_action_run(panel_dev, PM_DEVICE_ACTION_RESUME);
+            return;
+        }
+    }
+
+    panel_asleep = true;
+    LOG_INF("Display asleep");
+}
+
+// The display returns right after SLPOUT, the panel finishes waking up during the fade-in
+static void panel_wake(void)
+{
+    if (!panel_asleep)
+    {
+        return;
+    }
+
+    int ret;
+
+    if (!PANEL_SPI_SHARED)
+    {
+        ret = pm_device_action_run(panel_spi_dev, PM_DEVICE_ACTION_RESUME);
+        if (ret < 0 && ret != -EALREADY)
+        {
+            LOG_WRN("Failed to resume the display SPI (%d)", ret);
+            return;
+        }
+    }
+
+    ret = pm_device_action_run(panel_dev, PM_DEVICE_ACTION_RESUME);
+    if (ret < 0 && ret != -EALREADY)
+    {
+        // Still asleep, the next fade-in tries again
+        LOG_WRN("Failed to resume the display (%d)", ret);
+        return;
+    }
+
+    panel_asleep = false;
+    k_work_submit_to_queue(zmk_display_work_q(), &panel_redraw_work);
+    LOG_INF("Display awake");
+}
+
+#endif // CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+
 // Message queue used to send fade requests to the fade handler thread.
 // It holds up to 4 fade_request_t elements and ensures brightness updates are handled sequentially.
 K_MSGQ_DEFINE(fade_msgq, sizeof(struct fade_request_t), FADE_QUEUE_SIZE, 4);
@@ -235,11 +333,24 @@ void fade_thread(void)
         // Wait indefinitely for the next fade request to arrive in the queue
         if (k_msgq_get(&fade_msgq, &req, K_FOREVER) == 0)
         {
+#if CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+            if (req.to > 0)
+            {
+                panel_wake();
+            }
+#endif
 
             // Skip animation entirely if brightness difference is too small
             if (req.from == req.to || abs(req.to - req.from) <= 1)
             {
                 apply_brightness(req.to);
+#if CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+                // Same as after a full fade, a queued wake-up must not be overtaken by the sleep
+                if (req.to == 0 && k_msgq_num_used_get(&fade_msgq) == 0)
+                {
+                    panel_sleep();
+                }
+#endif
                 continue;
             }
 
@@ -276,6 +387,14 @@ void fade_thread(void)
             {
                 apply_brightness(req.to);
             }
+
+#if CONFIG_DONGLE_SCREEN_PANEL_SLEEP
+            // Only sleep if no new fade is waiting, e.g. a key press during the fade-out
+            if (req.to == 0 && k_msgq_num_used_get(&fade_msgq) == 0)
+            {
+                panel_sleep();
+            }
+#endif
         }
     }
 }
@@ -307,6 +426,9 @@ void set_screen_brightness(uint8_t value, bool ambient)
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0 || CONFIG_DONGLE_SCREEN_BRIGHTNESS_KEYBOARD_CONTROL
 // --- Brightness logic ---
 static bool screen_on = true;
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+static bool always_on_active = false; // Screen is dimmed and shows the always-on strip
+#endif
 // --- Screen on/off ---
 
 static void screen_set_on(bool on)
@@ -321,15 +443,32 @@ static void screen_set_on(bool on)
             LOG_DBG("SCREEN TURN ON: Adjusted brightness to ensure screen can turn on: %d", current_brightness);
         }
 
-        fade_to_brightness(0, clamp_brightness(current_brightness + brightness_modifier));
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+        if (always_on_active)
+        {
+            status_screen_set_always_on(false);
+            always_on_active = false;
+            fade_to_brightness(min_brightness, clamp_brightness(current_brightness + brightness_modifier));
+        }
+        else
+#endif
+        {
+            fade_to_brightness(0, clamp_brightness(current_brightness + brightness_modifier));
+        }
         screen_on = true;
         off_through_modifier = false; // Reset the flag, because the screen is turned on again
+#if CONFIG_DONGLE_SCREEN_FRAME_RATE_POLICY
+        frame_rate_set_dimmed(false);
+#endif
         LOG_INF("Screen on (smooth)");
     }
     else if (!on && screen_on)
     {
         fade_to_brightness(clamp_brightness(current_brightness + brightness_modifier), 0);
         screen_on = false;
+#if CONFIG_DONGLE_SCREEN_FRAME_RATE_POLICY
+        frame_rate_set_dimmed(true);
+#endif
         LOG_INF("Screen off (smooth)");
     }
     else
@@ -344,6 +483,27 @@ static void screen_set_on(bool on)
 
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0
 
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+// Dim to the minimum brightness and show the always-on strip instead of turning the screen off
+static void screen_set_always_on(void)
+{
+    if (!screen_on)
+    {
+        LOG_DBG("Screen is already off, no always-on strip");
+        return;
+    }
+
+    fade_to_brightness(clamp_brightness(current_brightness + brightness_modifier), min_brightness);
+    status_screen_set_always_on(true);
+    always_on_active = true;
+    screen_on = false;
+#if CONFIG_DONGLE_SCREEN_FRAME_RATE_POLICY
+    frame_rate_set_dimmed(true);
+#endif
+    LOG_INF("Screen always-on (smooth)");
+}
+#endif
+
 void screen_idle_thread(void)
 {
     while (1)
@@ -357,7 +517,11 @@ void screen_idle_thread(void)
 
             if (remaining <= 0)
             {
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+                screen_set_always_on();
+#else
                 screen_set_on(false);
+#endif
                 off_through_modifier = false; // Reset the flag, because the screen is turned off
                 // After turning off, sleep until next activity (key event will wake screen)
                 k_sleep(K_FOREVER);
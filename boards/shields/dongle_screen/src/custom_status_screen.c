@@ -34,15 +34,129 @@ static struct zmk_widget_wpm_status wpm_status_widget;
 static struct zmk_widget_mod_status mod_widget;
 #endif
 
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+#include <zephyr/device.h>
+#include <zmk/display.h>
+#include <drivers/display/st7789v.h>
+#include "widgets/aod_status.h"
+static struct zmk_widget_aod_status aod_status_widget;
+#endif
+
+#if CONFIG_DONGLE_SCREEN_DIRECT_RENDER
+#include "direct_render.h"
+#endif
+
+#if CONFIG_DONGLE_SCREEN_TICKLESS
+#include "display_sched.h"
+#endif
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 lv_style_t global_style;
 
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+
+// Lines of the panel kept scanning while always-on
+#define AOD_STRIP_LINES 80
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+static lv_obj_t *status_screen;
+static lv_obj_t *aod_screen;
+static uint16_t aod_strip_start;
+static bool always_on;
+
+// Scan the whole panel at full colour depth again
+static void aod_panel_normal(void)
+{
+    int ret;
+
+    ret = st7789v_set_idle_mode(display, false);
+    if (ret < 0)
+    {
+        LOG_ERR("Failed to leave the idle mode (%d)", ret);
+    }
+
+    ret = st7789v_set_partial_area(display, 0, 0);
+    if (ret < 0)
+    {
+        LOG_ERR("Failed to leave the partial mode (%d)", ret);
+    }
+}
+
+static void always_on_work_cb(struct k_work *work)
+{
+    int ret;
+
+    if (always_on)
+    {
+        lv_screen_load(aod_screen);
+        zmk_widget_aod_status_set_active(&aod_status_widget, true);
+        // Draw the strip at full colour depth before the panel drops to 8 colours
+        lv_refr_now(NULL);
+        ret = st7789v_set_partial_area(display, aod_strip_start, AOD_STRIP_LINES);
+        if (ret == 0)
+        {
+            ret = st7789v_set_idle_mode(display, true);
+        }
+        if (ret < 0)
+        {
+            // The strip screen also reads correctly on the full panel, only saves less power
+            LOG_ERR("Failed to enter the always-on panel mode (%d)", ret);
+            aod_panel_normal();
+            return;
+        }
+        LOG_INF("Screen always-on strip active");
+    }
+    else
+    {
+        aod_panel_normal();
+        zmk_widget_aod_status_set_active(&aod_status_widget, false);
+        lv_screen_load(status_screen);
+        LOG_INF("Screen always-on strip inactive");
+    }
+}
+
+static K_WORK_DEFINE(always_on_work, always_on_work_cb);
+
+void status_screen_set_always_on(bool on)
+{
+    always_on = on;
+    k_work_submit_to_queue(zmk_display_work_q(), &always_on_work);
+}
+
+static void aod_screen_create(void)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+
+    aod_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(aod_screen, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(aod_screen, 255, LV_PART_MAIN);
+    lv_obj_add_style(aod_screen, &global_style, LV_PART_MAIN);
+
+    // The panel scans along x when lying on the side, so the strip is a column there
+#if CONFIG_DONGLE_SCREEN_HORIZONTAL
+    aod_strip_start = (hor_res - AOD_STRIP_LINES) / 2;
+    zmk_widget_aod_status_init(&aod_status_widget, aod_screen, AOD_STRIP_LINES, ver_res);
+    lv_obj_set_pos(zmk_widget_aod_status_obj(&aod_status_widget), aod_strip_start, 0);
+#else
+    aod_strip_start = (ver_res - AOD_STRIP_LINES) / 2;
+    zmk_widget_aod_status_init(&aod_status_widget, aod_screen, hor_res, AOD_STRIP_LINES);
+    lv_obj_set_pos(zmk_widget_aod_status_obj(&aod_status_widget), 0, aod_strip_start);
+#endif
+}
+
+#endif // CONFIG_DONGLE_SCREEN_ALWAYS_ON
+
 lv_obj_t *zmk_display_status_screen()
 {
     lv_obj_t *screen;
 
+#if CONFIG_DONGLE_SCREEN_DIRECT_RENDER
+    direct_render_init();
+#endif
+
     screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(screen, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(screen, 255, LV_PART_MAIN);
@@ -81,5 +195,14 @@ lv_obj_t *zmk_display_status_screen()
     lv_obj_align(zmk_widget_mod_status_obj(&mod_widget), LV_ALIGN_CENTER, 0, 35);
 #endif
 
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+    status_screen = screen;
+    aod_screen_create();
+#endif
+
+#if CONFIG_DONGLE_SCREEN_TICKLESS
+    display_sched_init();
+#endif
+
     return screen;
 }
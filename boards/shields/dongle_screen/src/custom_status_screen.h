@@ -9,4 +9,12 @@
 
 #include <lvgl.h>
 
-lv_obj_t *zmk_display_status_screen();
\ No newline at end of file
+lv_obj_t *zmk_display_status_screen();
+
+#if CONFIG_DONGLE_SCREEN_ALWAYS_ON
+/**
+ * @brief Switch between the status screen and the always-on strip
+ * Called by the brightness logic when the screen idles or wakes up
+ */
+void status_screen_set_always_on(bool on);
+#endif
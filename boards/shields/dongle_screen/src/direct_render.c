@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+
+#include "direct_render.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Direct rendering: LVGL draws into a full screen buffer at the real screen position, so the
+// buffer always holds the whole frame and only the invalidated areas are redrawn and sent.
+// With two buffers LVGL copies the areas redrawn in the last frame into the other buffer
+// before drawing into it, keeping both in sync.
+
+#define DIRECT_RENDER_BUF_SIZE                                                                     \
+    (DT_PROP(DT_CHOSEN(zephyr_display), width) * DT_PROP(DT_CHOSEN(zephyr_display), height) *   \
+     sizeof(uint16_t))
+
+// A transfer still running while LVGL draws the next frame must have its own buffer
+BUILD_ASSERT(!IS_ENABLED(CONFIG_DONGLE_SCREEN_ASYNC_FLUSH) ||
+                 IS_ENABLED(CONFIG_DONGLE_SCREEN_DIRECT_RENDER_DOUBLE),
+             "Direct rendering with asynchronous flushes needs two buffers");
+
+// Backs up the RAM check in Kconfig with the size of the chosen SRAM
+BUILD_ASSERT(!IS_ENABLED(CONFIG_DONGLE_SCREEN_DIRECT_RENDER_DOUBLE) ||
+                 2 * DIRECT_RENDER_BUF_SIZE < DT_REG_SIZE(DT_CHOSEN(zephyr_sram)),
+             "Two full screen buffers do not fit into the RAM of this SoC");
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static uint8_t direct_buf_1[DIRECT_RENDER_BUF_SIZE] __aligned(LV_DRAW_BUF_ALIGN);
+#if CONFIG_DONGLE_SCREEN_DIRECT_RENDER_DOUBLE
+static uint8_t direct_buf_2[DIRECT_RENDER_BUF_SIZE] __aligned(LV_DRAW_BUF_ALIGN);
+#endif
+
+static void direct_render_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    // px_map is the start of the full screen buffer, the area sits at its screen position
+    uint32_t stride = lv_display_get_horizontal_resolution(disp);
+    struct display_buffer_descriptor desc = {
+        .width = lv_area_get_width(area),
+        .height = lv_area_get_height(area),
+        .pitch = stride,
+    };
+    const uint8_t *start = px_map + (area->y1 * stride + area->x1) * sizeof(uint16_t);
+    int ret;
+
+    // The last row ends after width pixels, a full stride there could run past the buffer
+    desc.buf_size = ((desc.height - 1) * stride + desc.width) * sizeof(uint16_t);
+
+    // Lets the driver hold only the first area of a frame for the tearing effect signal
+    desc.frame_incomplete = !lv_display_flush_is_last(disp);
+
+    ret = display_write(display, area->x1, area->y1, &desc, start);
+    if (ret < 0)
+    {
+        LOG_ERR("Failed to write area %dx%d at %d,%d (%d)", desc.width, desc.height, area->x1,
+                area->y1, ret);
+    }
+    lv_display_flush_ready(disp);
+}
+
+void direct_render_init(void)
+{
+    lv_display_t *disp = lv_display_get_default();
+    void *buf_2 = NULL;
+
+#if CONFIG_DONGLE_SCREEN_DIRECT_RENDER_DOUBLE
+    buf_2 = direct_buf_2;
+#endif
+
+    lv_display_set_buffers(disp, direct_buf_1, buf_2, sizeof(direct_buf_1),
+                           LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, direct_render_flush_cb);
+
+    LOG_INF("Direct rendering into %d full screen buffer(s)", buf_2 != NULL ? 2 : 1);
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @brief Switch LVGL to direct rendering into full screen buffers
+ * Called once from the display thread before the status screen is built
+ */
+void direct_render_init(void);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <zmk/display.h>
+
+#include "display_sched.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Tickless display scheduling: instead of the fixed ZMK display tick, LVGL runs when its next
+// timer is due. The refresh timer is paused while nothing is invalidated or animating, so a
+// static status screen causes no wake-ups at all. Invalidating an area, starting an animation
+// or creating a timer resumes LVGL through its timer resume callback.
+
+static lv_display_t *disp;
+static lv_timer_t *refr_timer;
+
+// Only touched from the display thread
+static bool redraw_pending = false;
+static bool active = false;
+static uint32_t wakeups;
+static int64_t wakeups_since;
+
+static void display_sched_cb(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(display_sched_work, display_sched_cb);
+
+static void display_sched_kick(void *data)
+{
+    k_work_reschedule_for_queue(zmk_display_work_q(), &display_sched_work, K_NO_WAIT);
+}
+
+static void display_sched_set_active(bool on)
+{
+    if (on == active)
+    {
+        return;
+    }
+
+    active = on;
+    LOG_DBG("Display refresh %s, target %u Hz", on ? "active" : "static",
+            display_sched_target_hz());
+}
+
+static void display_sched_cb(struct k_work *work)
+{
+    wakeups++;
+    lv_timer_handler();
+
+    // Nothing left to draw and nothing moving: stop the refresh timer until the next change
+    if (!redraw_pending && lv_anim_count_running() == 0)
+    {
+        lv_timer_pause(refr_timer);
+        display_sched_set_active(false);
+    }
+    else
+    {
+        display_sched_set_active(true);
+    }
+
+    uint32_t next_ms = lv_timer_get_time_until_next();
+
+    if (next_ms != LV_NO_TIMER_READY)
+    {
+        k_work_reschedule_for_queue(zmk_display_work_q(), &display_sched_work, K_MSEC(next_ms));
+    }
+}
+
+static void display_sched_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA)
+    {
+        redraw_pending = true;
+        // Calls the resume callback, which wakes the scheduler
+        lv_timer_resume(refr_timer);
+    }
+    else
+    {
+        redraw_pending = false;
+    }
+}
+
+uint32_t display_sched_target_hz(void)
+{
+    if (!active || refr_timer == NULL)
+    {
+        return 0;
+    }
+
+    return MSEC_PER_SEC / lv_timer_get_period(refr_timer);
+}
+
+uint32_t display_sched_current_hz(void)
+{
+    int64_t now = k_uptime_get();
+    int64_t elapsed = now - wakeups_since;
+    uint32_t hz = elapsed > 0 ? (uint32_t)(wakeups * MSEC_PER_SEC / elapsed) : 0;
+
+    wakeups = 0;
+    wakeups_since = now;
+
+    return hz;
+}
+
+void display_sched_init(void)
+{
+    disp = lv_display_get_default();
+    refr_timer = lv_display_get_refr_timer(disp);
+    wakeups_since = k_uptime_get();
+
+    lv_display_add_event_cb(disp, display_sched_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(disp, display_sched_event_cb, LV_EVENT_REFR_READY, NULL);
+    lv_timer_handler_set_resume_cb(display_sched_kick, NULL);
+
+    redraw_pending = true;
+    display_sched_kick(NULL);
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Start running LVGL on demand instead of on a fixed tick
+ * Called once from the display thread after the status screen is built
+ */
+void display_sched_init(void);
+
+/**
+ * @brief Refresh rate the scheduler aims for
+ * @return Refresh rate in Hz while something animates or waits to be drawn, 0 while static
+ */
+uint32_t display_sched_target_hz(void);
+
+/**
+ * @brief LVGL runs per second since the last call
+ * @return Measured wake-ups per second
+ */
+uint32_t display_sched_current_hz(void);
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <zmk/display.h>
+#include <drivers/display/st7789v.h>
+
+#include "status_state.h"
+
+#if CONFIG_DONGLE_SCREEN_TICKLESS
+#include "display_sched.h"
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Periodically logs what the display driver put on the bus since the last line, so the cost
+// of enabling a widget or changing refresh settings can be compared in the log. The frame
+// times cover LVGL rendering plus the flushes, to compare partial and direct rendering.
+// The overdraw counts the backgrounds painted per redrawn pixel, 1.00 means only the screen.
+
+#define DISPLAY_STATS_INTERVAL_S CONFIG_DONGLE_SCREEN_DISPLAY_STATS_INTERVAL_S
+
+#if CONFIG_DONGLE_SCREEN_DIRECT_RENDER
+#define DISPLAY_STATS_MODE "direct"
+#else
+#define DISPLAY_STATS_MODE "partial"
+#endif
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// Only touched from the display thread
+static bool frame_events_added = false;
+static uint32_t frame_start;
+static uint32_t frames;
+static uint32_t frame_us_total;
+static uint32_t frame_us_max;
+static uint64_t invalidated_px;
+static uint64_t painted_px;
+
+static void display_stats_frame_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START)
+    {
+        frame_start = k_cycle_get_32();
+        return;
+    }
+
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - frame_start);
+
+    frames++;
+    frame_us_total += us;
+    frame_us_max = MAX(frame_us_max, us);
+}
+
+// Pixels of area covered by the backgrounds of obj and its children, counted once per layer
+static uint32_t display_stats_painted(lv_obj_t *obj, const lv_area_t *area)
+{
+    lv_area_t coords;
+    lv_area_t clip;
+    uint32_t painted = 0;
+
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN))
+    {
+        return 0;
+    }
+
+    lv_obj_get_coords(obj, &coords);
+    if (!lv_area_intersect(&clip, area, &coords))
+    {
+        return 0;
+    }
+
+    if (lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) > LV_OPA_TRANSP)
+    {
+        painted += lv_area_get_size(&clip);
+    }
+
+    // Children are clipped to their parent
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++)
+    {
+        painted += display_stats_painted(lv_obj_get_child(obj, i), &clip);
+    }
+
+    return painted;
+}
+
+static void display_stats_invalidate_cb(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+
+    invalidated_px += lv_area_get_size(area);
+    painted_px += display_stats_painted(lv_screen_active(), area);
+}
+
+// Backgrounds per pixel in hundredths
+static uint32_t display_stats_overdraw(uint64_t painted, uint64_t pixels)
+{
+    return pixels > 0 ? (uint32_t)(painted * 100 / pixels) : 0;
+}
+
+static void display_stats_cb(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(display_stats_work, display_stats_cb);
+
+// Runs on the display work queue, next to the LVGL calls of the status screen
+static void display_stats_cb(struct k_work *work)
+{
+    struct st7789v_stats stats;
+
+    if (!frame_events_added)
+    {
+        lv_display_t *disp = lv_display_get_default();
+
+        if (disp != NULL)
+        {
+            lv_display_add_event_cb(disp, display_stats_frame_cb, LV_EVENT_RENDER_START, NULL);
+            lv_display_add_event_cb(disp, display_stats_frame_cb, LV_EVENT_RENDER_READY, NULL);
+            lv_display_add_event_cb(disp, display_stats_invalidate_cb, LV_EVENT_INVALIDATE_AREA,
+                                    NULL);
+            frame_events_added = true;
+        }
+    }
+
+    st7789v_get_stats(display, &stats);
+    st7789v_reset_stats(display);
+
+    LOG_INF("Display: %u writes/s, %u bytes/s, %u transfers/s, busy %u us/s, max %u us",
+            stats.flushes / DISPLAY_STATS_INTERVAL_S,
+            (uint32_t)(stats.bytes / DISPLAY_STATS_INTERVAL_S),
+            stats.transfers / DISPLAY_STATS_INTERVAL_S, stats.busy_us / DISPLAY_STATS_INTERVAL_S,
+            stats.max_us);
+    LOG_INF("Display: %u fills, %u dropped, %u errors, %u CASET, %u RASET", stats.fills,
+            stats.dropped, stats.errors, stats.caset, stats.raset);
+    LOG_INF("Display write latency <1/2/4/8/16/32/64/more ms: %u %u %u %u %u %u %u %u",
+            stats.latency[0], stats.latency[1], stats.latency[2], stats.latency[3],
+            stats.latency[4], stats.latency[5], stats.latency[6], stats.latency[7]);
+    LOG_INF("Display %s render: %u frames, %u us avg, %u us max, %u bytes/frame",
+            DISPLAY_STATS_MODE, frames, frames > 0 ? frame_us_total / frames : 0, frame_us_max,
+            frames > 0 ? (uint32_t)(stats.bytes / frames) : 0);
+
+    LOG_INF("Display widgets: %u unchanged updates skipped", status_state_take_skipped());
+
+    lv_obj_t *screen = lv_screen_active();
+
+    if (screen != NULL)
+    {
+        lv_area_t screen_area;
+
+        lv_obj_get_coords(screen, &screen_area);
+
+        uint32_t redraw = display_stats_overdraw(painted_px, invalidated_px);
+        uint32_t full = display_stats_overdraw(display_stats_painted(screen, &screen_area),
+                                               lv_area_get_size(&screen_area));
+
+        LOG_INF("Display overdraw: %u.%02u redrawn, %u.%02u full screen", redraw / 100,
+                redraw % 100, full / 100, full % 100);
+    }
+
+#if CONFIG_DONGLE_SCREEN_TICKLESS
+    LOG_INF("Display refresh: %u Hz target, %u Hz current", display_sched_target_hz(),
+            display_sched_current_hz());
+#endif
+
+    frames = 0;
+    frame_us_total = 0;
+    frame_us_max = 0;
+    invalidated_px = 0;
+    painted_px = 0;
+
+    k_work_schedule_for_queue(zmk_display_work_q(), &display_stats_work,
+                              K_SECONDS(DISPLAY_STATS_INTERVAL_S));
+}
+
+static int display_stats_init(void)
+{
+    k_work_schedule_for_queue(zmk_display_work_q(), &display_stats_work,
+                              K_SECONDS(DISPLAY_STATS_INTERVAL_S));
+    return 0;
+}
+
+SYS_INIT(display_stats_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <drivers/display/st7789v.h>
+
+#include "frame_rate.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Frame rate policy: typing runs animations (WPM, bongo cat, mods), so the panel refreshes
+// at the active rate while keys are pressed and drops to the idle rate once the UI settles.
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static uint8_t target_hz = CONFIG_DONGLE_SCREEN_FRAME_RATE_ACTIVE_HZ;
+static uint8_t applied_hz = 0;
+static bool screen_dimmed = false;
+
+// Runs on the display work queue, so the command never lands in the middle of a flush
+static void frame_rate_apply_cb(struct k_work *work)
+{
+    uint8_t hz = target_hz;
+
+    if (hz == applied_hz)
+    {
+        return;
+    }
+
+    int ret = st7789v_set_frame_rate(display, hz);
+    if (ret < 0)
+    {
+        LOG_WRN("Failed to set frame rate to %d Hz (%d)", hz, ret);
+        return;
+    }
+
+    applied_hz = hz;
+    LOG_DBG("Screen frame rate %d Hz", ret);
+}
+
+static K_WORK_DEFINE(frame_rate_apply_work, frame_rate_apply_cb);
+
+static void frame_rate_set(uint8_t hz)
+{
+    target_hz = hz;
+    k_work_submit_to_queue(zmk_display_work_q(), &frame_rate_apply_work);
+}
+
+static void frame_rate_idle_cb(struct k_work *work)
+{
+    frame_rate_set(CONFIG_DONGLE_SCREEN_FRAME_RATE_IDLE_HZ);
+}
+
+static K_WORK_DELAYABLE_DEFINE(frame_rate_idle_work, frame_rate_idle_cb);
+
+static void frame_rate_activity(void)
+{
+    if (screen_dimmed)
+    {
+        return;
+    }
+
+    frame_rate_set(CONFIG_DONGLE_SCREEN_FRAME_RATE_ACTIVE_HZ);
+    k_work_reschedule(&frame_rate_idle_work, K_MSEC(CONFIG_DONGLE_SCREEN_FRAME_RATE_IDLE_DELAY_MS));
+}
+
+void frame_rate_set_dimmed(bool dimmed)
+{
+    screen_dimmed = dimmed;
+
+    if (dimmed)
+    {
+        k_work_cancel_delayable(&frame_rate_idle_work);
+        frame_rate_set(CONFIG_DONGLE_SCREEN_FRAME_RATE_IDLE_HZ);
+    }
+    else
+    {
+        frame_rate_activity();
+    }
+}
+
+static int frame_rate_listener(const zmk_event_t *eh)
+{
+    frame_rate_activity();
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(frame_rate, frame_rate_listener);
+ZMK_SUBSCRIPTION(frame_rate, zmk_keycode_state_changed);
+ZMK_SUBSCRIPTION(frame_rate, zmk_layer_state_changed);
+
+static int frame_rate_init(void)
+{
+    // The panel boots at 60 Hz, drop to the idle rate once the status screen has settled
+    k_work_schedule(&frame_rate_idle_work, K_MSEC(CONFIG_DONGLE_SCREEN_FRAME_RATE_IDLE_DELAY_MS));
+    return 0;
+}
+
+SYS_INIT(frame_rate_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
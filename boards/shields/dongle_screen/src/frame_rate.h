@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Hold the panel at the idle frame rate while the screen is dimmed or off
+ * Called by the brightness logic when the screen turns off or on
+ */
+void frame_rate_set_dimmed(bool dimmed);
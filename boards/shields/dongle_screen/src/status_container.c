@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lvgl.h>
+
+#include "status_container.h"
+
+lv_obj_t *status_container_create(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+
+    // Drops the theme styles: the opaque background and border were painted over the black
+    // screen on every redraw of a label inside, the padding and scrollbar were unused.
+    // Inherited text styles still come from the screen.
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+    return obj;
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/**
+ * @brief Create a container that only positions its children
+ * It has no background, border, padding or scrollbar, so the screen background stays the
+ * only layer painted below the widgets.
+ * @param parent Object to create the container in
+ * @return The new container
+ */
+lv_obj_t *status_container_create(lv_obj_t *parent);
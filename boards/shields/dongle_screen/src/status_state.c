@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zmk/display.h>
+
+#include "status_state.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Status state aggregation: every widget listener stores its latest state in one shared
+// snapshot instead of submitting its own display work. A burst of events, like a profile
+// switch that also changes the layer and the battery, then ends up in one LVGL pass.
+
+static K_MUTEX_DEFINE(status_state_mutex);
+
+// Protected by the mutex
+static sys_slist_t parts = SYS_SLIST_STATIC_INIT(&parts);
+
+static atomic_t skipped;
+
+static void status_state_cb(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(status_state_work, status_state_cb);
+
+void status_state_lock(void) { k_mutex_lock(&status_state_mutex, K_FOREVER); }
+
+void status_state_unlock(void) { k_mutex_unlock(&status_state_mutex); }
+
+void status_state_count_skipped(void) { atomic_inc(&skipped); }
+
+uint32_t status_state_take_skipped(void) { return (uint32_t)atomic_clear(&skipped); }
+
+void status_state_register(struct status_state_part *part)
+{
+    // The part is static, a second widget instance or a re-init must not link it twice
+    if (sys_slist_find(&parts, &part->node, NULL))
+    {
+        return;
+    }
+
+    part->dirty = false;
+    sys_slist_append(&parts, &part->node);
+}
+
+void status_state_mark_dirty(struct status_state_part *part)
+{
+    part->dirty = true;
+
+    // Does not push an already scheduled batch out, so a stream of events cannot starve it
+    k_work_schedule_for_queue(zmk_display_work_q(), &status_state_work,
+                              K_MSEC(CONFIG_DONGLE_SCREEN_STATUS_BATCH_MS));
+}
+
+// Runs on the display work queue
+static void status_state_cb(struct k_work *work)
+{
+    struct status_state_part *part;
+    int count = 0;
+
+    // Copy all changes at once so the widgets show one consistent snapshot
+    status_state_lock();
+    SYS_SLIST_FOR_EACH_CONTAINER(&parts, part, node)
+    {
+        part->taken = part->dirty;
+        if (part->dirty)
+        {
+            part->take();
+            part->dirty = false;
+            count++;
+        }
+    }
+    status_state_unlock();
+
+    // The widgets only invalidate their areas here, LVGL draws all of them in its next refresh
+    SYS_SLIST_FOR_EACH_CONTAINER(&parts, part, node)
+    {
+        if (part->taken)
+        {
+            part->apply();
+        }
+    }
+
+    LOG_DBG("Applied %d widget updates in one batch", count);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <zephyr/sys/slist.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+
+/**
+ * @brief One widget's share of the status snapshot
+ * The listener writes the state and marks the part dirty, the display thread copies all dirty
+ * parts in one go and applies them in a single batch.
+ */
+struct status_state_part
+{
+    sys_snode_t node;
+    // Copies the latest state for the display thread, called with the lock held
+    void (*take)(void);
+    // Updates the widgets from the copied state, called on the display thread
+    void (*apply)(void);
+    // Changed since the last batch, protected by the lock
+    bool dirty;
+    // Copied into the running batch, only touched from the display thread
+    bool taken;
+};
+
+/**
+ * @brief Lock the status snapshot shared by all widgets
+ */
+void status_state_lock(void);
+
+/**
+ * @brief Unlock the status snapshot
+ */
+void status_state_unlock(void);
+
+/**
+ * @brief Add a widget to the batched updates
+ * Called with the lock held. Registering the same widget again has no effect.
+ */
+void status_state_register(struct status_state_part *part);
+
+/**
+ * @brief Queue a widget for the next batch
+ * Called with the lock held. The first change starts the batch window, later changes within
+ * it are drawn in the same LVGL pass.
+ */
+void status_state_mark_dirty(struct status_state_part *part);
+
+/**
+ * @brief Count a widget update that was dropped because the widget already shows the state
+ * Called from the widget callbacks on the display thread
+ */
+void status_state_count_skipped(void);
+
+/**
+ * @brief Widget updates skipped since the last call
+ * @return Number of updates the widgets dropped as unchanged
+ */
+uint32_t status_state_take_skipped(void);
+
+/**
+ * @brief Drop-in for ZMK_DISPLAY_WIDGET_LISTENER that batches updates across widgets
+ * The event listener only stores the state from state_func, cb runs on the display thread
+ * together with the pending changes of all other widgets. Defines listener##_init() which
+ * applies the current state right away.
+ */
+#define STATUS_STATE_WIDGET_LISTENER(listener, state_type, cb, state_func)                        \
+    static state_type __##listener##_state;                                                        \
+    static state_type __##listener##_shown;                                                        \
+    static void listener##_take(void) { __##listener##_shown = __##listener##_state; }             \
+    static void listener##_apply(void) { cb(__##listener##_shown); }                               \
+    static struct status_state_part __##listener##_part = {                                        \
+        .take = listener##_take,                                                                   \
+        .apply = listener##_apply,                                                                 \
+    };                                                                                             \
+    static int listener##_cb(const zmk_event_t *eh)                                                \
+    {                                                                                              \
+        if (zmk_display_is_initialized())                                                          \
+        {                                                                                          \
+            status_state_lock();                                                                   \
+            __##listener##_state = state_func(eh);                                                 \
+            status_state_mark_dirty(&__##listener##_part);                                         \
+            status_state_unlock();                                                                 \
+        }                                                                                          \
+        return ZMK_EV_EVENT_BUBBLE;                                                                \
+    }                                                                                              \
+    ZMK_LISTENER(listener, listener##_cb);                                                         \
+    static void listener##_init(void)                                                              \
+    {                                                                                              \
+        status_state_lock();                                                                       \
+        __##listener##_state = state_func(NULL);                                                   \
+        listener##_take();                                                                         \
+        status_state_register(&__##listener##_part);                                               \
+        status_state_unlock();                                                                     \
+        listener##_apply();                                                                        \
+    }
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/keymap.h>
+
+#include "aod_status.h"
+#include "../status_container.h"
+#include "../status_state.h"
+
+// Battery levels are only cached here and drawn on the next refresh of the strip, protected by
+// the status state lock
+static uint8_t peripheral_levels[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT];
+
+static int aod_battery_listener(const zmk_event_t *eh)
+{
+    const struct zmk_peripheral_battery_state_changed *ev = as_zmk_peripheral_battery_state_changed(eh);
+    if (ev != NULL && ev->source < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT)
+    {
+        status_state_lock();
+        peripheral_levels[ev->source] = ev->state_of_charge;
+        status_state_unlock();
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(widget_aod_status, aod_battery_listener);
+ZMK_SUBSCRIPTION(widget_aod_status, zmk_peripheral_battery_state_changed);
+
+// Most refreshes show the same layer and levels, setting the same text would still redraw the label
+static void aod_status_set_text(lv_obj_t *label, const char *text)
+{
+    if (strcmp(lv_label_get_text(label), text) == 0)
+    {
+        status_state_count_skipped();
+        return;
+    }
+
+    lv_label_set_text(label, text);
+}
+
+static void aod_status_refresh(struct zmk_widget_aod_status *widget)
+{
+    uint8_t levels[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT];
+    uint8_t index = zmk_keymap_highest_layer_active();
+    const char *name = zmk_keymap_layer_name(index);
+    char text[8];
+
+    status_state_lock();
+    memcpy(levels, peripheral_levels, sizeof(levels));
+    status_state_unlock();
+
+    if (name == NULL)
+    {
+        snprintf(text, sizeof(text), "%i", index);
+        name = text;
+    }
+    aod_status_set_text(widget->layer_label, name);
+
+    for (int i = 0; i < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT; i++)
+    {
+        if (levels[i] > 0)
+        {
+            snprintf(text, sizeof(text), "%u%%", levels[i]);
+            aod_status_set_text(widget->battery_labels[i], text);
+        }
+        else
+        {
+            aod_status_set_text(widget->battery_labels[i], "X");
+        }
+    }
+
+    LOG_DBG("Always-on strip refreshed");
+}
+
+static void aod_status_timer_cb(lv_timer_t *timer)
+{
+    aod_status_refresh(lv_timer_get_user_data(timer));
+}
+
+void zmk_widget_aod_status_set_active(struct zmk_widget_aod_status *widget, bool active)
+{
+    if (active)
+    {
+        aod_status_refresh(widget);
+        lv_timer_reset(widget->timer);
+        lv_timer_resume(widget->timer);
+    }
+    else
+    {
+        lv_timer_pause(widget->timer);
+    }
+}
+
+int zmk_widget_aod_status_init(struct zmk_widget_aod_status *widget, lv_obj_t *parent, int32_t width, int32_t height)
+{
+    widget->obj = status_container_create(parent);
+    lv_obj_set_size(widget->obj, width, height);
+    lv_obj_set_style_pad_all(widget->obj, 2, LV_PART_MAIN);
+
+    // Lay the labels out along the longer side of the strip
+    lv_obj_set_flex_flow(widget->obj, width > height ? LV_FLEX_FLOW_ROW : LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(widget->obj, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    widget->layer_label = lv_label_create(widget->obj);
+    lv_label_set_long_mode(widget->layer_label, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_max_width(widget->layer_label, width > height ? width / 2 : width - 4, LV_PART_MAIN);
+
+    for (int i = 0; i < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT; i++)
+    {
+        widget->battery_labels[i] = lv_label_create(widget->obj);
+    }
+
+    widget->timer = lv_timer_create(aod_status_timer_cb, CONFIG_DONGLE_SCREEN_ALWAYS_ON_REFRESH_S * 1000, widget);
+    lv_timer_pause(widget->timer);
+
+    return 0;
+}
+
+lv_obj_t *zmk_widget_aod_status_obj(struct zmk_widget_aod_status *widget)
+{
+    return widget->obj;
+}
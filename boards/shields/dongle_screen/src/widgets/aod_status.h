@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include <zmk/split/central.h>
+
+// aod_status.h
+struct zmk_widget_aod_status
+{
+    lv_obj_t *obj;
+    lv_obj_t *layer_label;
+    lv_obj_t *battery_labels[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT];
+    lv_timer_t *timer;
+};
+
+int zmk_widget_aod_status_init(struct zmk_widget_aod_status *widget, lv_obj_t *parent, int32_t width, int32_t height);
+lv_obj_t *zmk_widget_aod_status_obj(struct zmk_widget_aod_status *widget);
+
+/**
+ * @brief Start or stop the periodic refresh of the strip
+ * Refreshes the strip right away when activated.
+ */
+void zmk_widget_aod_status_set_active(struct zmk_widget_aod_status *widget, bool active);
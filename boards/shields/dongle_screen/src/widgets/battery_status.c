@@ -20,6 +20,8 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include "battery_status.h"
 #include "../brightness.h"
+#include "../status_state.h"
+#include "../status_container.h"
 
 #if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
     #define SOURCE_OFFSET 1
@@ -29,12 +31,27 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
+#define BATTERY_SOURCES (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET)
+
 struct battery_state {
     uint8_t source;
     uint8_t level;
     bool usb_present;
 };
 
+// Levels of all sources, so a batch holding events from both halves shows both
+struct battery_status_state {
+    struct battery_state sources[BATTERY_SOURCES];
+    uint32_t seen;
+};
+
+// Filled from the events, protected by the status state lock
+static struct battery_status_state battery_snapshot;
+
+// Levels on the screen, a source is only redrawn when its level or USB power changes
+static struct battery_state battery_shown[BATTERY_SOURCES];
+static uint32_t battery_shown_valid;
+
 struct battery_object {
     lv_obj_t *symbol;
     lv_obj_t *label;
@@ -169,9 +186,25 @@ static void set_battery_symbol(lv_obj_t *widget, struct battery_state state) {
 
 }
 
-void battery_status_update_cb(struct battery_state state) {
+static void battery_status_update_cb(struct battery_status_state state) {
     struct zmk_widget_dongle_battery_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_battery_symbol(widget->obj, state); }
+    for (int i = 0; i < BATTERY_SOURCES; i++) {
+        if (!(state.seen & BIT(i))) {
+            continue;
+        }
+
+        // Peripherals repeat their level, and the other source's level rides along in the batch
+        if ((battery_shown_valid & BIT(i)) && battery_shown[i].level == state.sources[i].level &&
+            battery_shown[i].usb_present == state.sources[i].usb_present) {
+            status_state_count_skipped();
+            continue;
+        }
+
+        SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_battery_symbol(widget->obj, state.sources[i]); }
+
+        battery_shown[i] = state.sources[i];
+        battery_shown_valid |= BIT(i);
+    }
 }
 
 static struct battery_state peripheral_battery_status_get_state(const zmk_event_t *eh) {
@@ -193,16 +226,25 @@ static struct battery_state central_battery_status_get_state(const zmk_event_t *
     };
 }
 
-static struct battery_state battery_status_get_state(const zmk_event_t *eh) { 
+static struct battery_status_state battery_status_get_state(const zmk_event_t *eh) { 
+    struct battery_state state;
+
     if (as_zmk_peripheral_battery_state_changed(eh) != NULL) {
-        return peripheral_battery_status_get_state(eh);
+        state = peripheral_battery_status_get_state(eh);
     } else {
-        return central_battery_status_get_state(eh);
+        state = central_battery_status_get_state(eh);
+    }
+
+    if (state.source < BATTERY_SOURCES) {
+        battery_snapshot.sources[state.source] = state;
+        battery_snapshot.seen |= BIT(state.source);
     }
+
+    return battery_snapshot;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_dongle_battery_status, struct battery_state,
-                            battery_status_update_cb, battery_status_get_state)
+STATUS_STATE_WIDGET_LISTENER(widget_dongle_battery_status, struct battery_status_state,
+                             battery_status_update_cb, battery_status_get_state)
 
 ZMK_SUBSCRIPTION(widget_dongle_battery_status, zmk_peripheral_battery_state_changed);
 
@@ -217,7 +259,7 @@ ZMK_SUBSCRIPTION(widget_dongle_battery_status, zmk_usb_conn_state_changed);
 #endif /* IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY) */
 
 int zmk_widget_dongle_battery_status_init(struct zmk_widget_dongle_battery_status *widget, lv_obj_t *parent) {
-    widget->obj = lv_obj_create(parent);
+    widget->obj = status_container_create(parent);
 
     lv_obj_set_size(widget->obj, 240, 40);
     
@@ -244,6 +286,9 @@ int zmk_widget_dongle_battery_status_init(struct zmk_widget_dongle_battery_statu
     // Initialize peripheral tracking
     init_peripheral_tracking();
 
+    // The new objects are hidden, draw every known source again
+    battery_shown_valid = 0;
+
     widget_dongle_battery_status_init();
 
     return 0;
@@ -17,6 +17,7 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/hid_indicators.h>
 #include <zmk/events/hid_indicators_changed.h>
 #include "bongo_cat.h"
+#include "../status_state.h"
 
 #define LED_CLCK 0x02
 
@@ -134,8 +135,8 @@ void bongo_cat_wpm_status_update_cb(struct bongo_cat_wpm_status_state state) {
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_animation(widget->obj, state); }
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_bongo_cat, struct bongo_cat_wpm_status_state, bongo_cat_wpm_status_update_cb,
-                            bongo_cat_wpm_status_get_state)
+STATUS_STATE_WIDGET_LISTENER(widget_bongo_cat, struct bongo_cat_wpm_status_state, bongo_cat_wpm_status_update_cb,
+                             bongo_cat_wpm_status_get_state)
 
 ZMK_SUBSCRIPTION(widget_bongo_cat, zmk_wpm_state_changed);
 ZMK_SUBSCRIPTION(widget_bongo_cat, zmk_hid_indicators_changed);
@@ -15,8 +15,60 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/endpoints.h>
 #include <zmk/keymap.h>
 
+#include "../status_state.h"
+
+#if CONFIG_DONGLE_SCREEN_LAYER_SLIDE
+#include <zephyr/device.h>
+#include <drivers/display/st7789v.h>
+#endif
+
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
+#if CONFIG_DONGLE_SCREEN_LAYER_SLIDE
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static void layer_slide_exec_cb(void *var, int32_t value)
+{
+    st7789v_set_scroll_offset(display, (uint16_t)value);
+}
+
+// Scroll the rows of the label in hardware, each step is a single scroll command instead of a repaint
+static void layer_slide_start(lv_obj_t *label)
+{
+    lv_area_t coords;
+    lv_anim_t anim;
+
+    if (lv_obj_get_screen(label) != lv_screen_active())
+    {
+        return;
+    }
+
+    lv_obj_update_layout(label);
+    lv_obj_get_coords(label, &coords);
+    if (coords.y1 < 0 || coords.y2 >= lv_display_get_vertical_resolution(NULL))
+    {
+        return;
+    }
+
+    int32_t lines = lv_area_get_height(&coords);
+    if (st7789v_set_scroll_area(display, coords.y1, lines) < 0)
+    {
+        return;
+    }
+
+    // Start with the new name shifted down by half its height and let it slide up into place
+    st7789v_set_scroll_offset(display, lines - lines / 2);
+
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, label);
+    lv_anim_set_exec_cb(&anim, layer_slide_exec_cb);
+    lv_anim_set_values(&anim, lines - lines / 2, lines);
+    lv_anim_set_duration(&anim, CONFIG_DONGLE_SCREEN_LAYER_SLIDE_DURATION_MS);
+    lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
+    lv_anim_start(&anim);
+}
+#endif
+
 struct layer_status_state
 {
     uint8_t index;
@@ -41,12 +93,37 @@ static void set_layer_symbol(lv_obj_t *label, struct layer_status_state state)
 
         lv_label_set_text(label, text);
     }
+
+#if CONFIG_DONGLE_SCREEN_LAYER_SLIDE
+    static bool first_update = true;
+
+    // The first name is drawn in place
+    if (!first_update)
+    {
+        layer_slide_start(label);
+    }
+    first_update = false;
+#endif
 }
 
+// Layer on the labels, all widgets show the same one
+static struct layer_status_state shown;
+static bool shown_valid = false;
+
 static void layer_status_update_cb(struct layer_status_state state)
 {
+    // Changes of layers below the highest one keep the name, and must not restart the slide
+    if (shown_valid && shown.index == state.index && shown.label == state.label)
+    {
+        status_state_count_skipped();
+        return;
+    }
+
     struct zmk_widget_layer_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_layer_symbol(widget->obj, state); }
+
+    shown = state;
+    shown_valid = true;
 }
 
 static struct layer_status_state layer_status_get_state(const zmk_event_t *eh)
@@ -57,8 +134,8 @@ static struct layer_status_state layer_status_get_state(const zmk_event_t *eh)
         .label = zmk_keymap_layer_name(index)};
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_layer_status, struct layer_status_state, layer_status_update_cb,
-                            layer_status_get_state)
+STATUS_STATE_WIDGET_LISTENER(widget_layer_status, struct layer_status_state, layer_status_update_cb,
+                             layer_status_get_state)
 
 ZMK_SUBSCRIPTION(widget_layer_status, zmk_layer_state_changed);
 
@@ -70,6 +147,8 @@ int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_
 
     sys_slist_append(&widgets, &widget->node);
 
+    // The new label is empty, draw it even if the layer did not change
+    shown_valid = false;
     widget_layer_status_init();
     return 0;
 }
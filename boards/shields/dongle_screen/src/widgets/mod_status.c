@@ -1,70 +1,171 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
 #include <zmk/hid.h>
+#include <zmk/keys.h>
 #include <lvgl.h>
 #include "mod_status.h"
+#include "../status_state.h"
+#include "../status_container.h"
 #include <fonts.h> // <-- Wichtig für LV_FONT_DECLARE
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-static void update_mod_status(struct zmk_widget_mod_status *widget)
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+struct mod_status_state
+{
+    uint8_t mods;
+};
+
+// Presses held per modifier bit, so releasing one of two keys sending the same modifier keeps
+// it shown, and the implicit modifiers of the last pressed key (e.g. LS(A))
+static uint8_t explicit_mod_counts[MOD_STATUS_SLOTS];
+static uint8_t implicit_mods;
+
+static uint8_t explicit_mods(void)
 {
-    uint8_t mods = zmk_hid_get_keyboard_report()->body.modifiers;
-    char text[32] = "";
-    int idx = 0;
-
-    // Temporäre Puffer für Symbole
-    char *syms[4];
-    int n = 0;
-
-    if (mods & (MOD_LCTL | MOD_RCTL))
-        syms[n++] = "󰘴";
-    if (mods & (MOD_LSFT | MOD_RSFT))
-        syms[n++] = "󰘶"; // U+F0636
-    if (mods & (MOD_LALT | MOD_RALT))
-        syms[n++] = "󰘵"; // U+F0635
-    if (mods & (MOD_LGUI | MOD_RGUI))
-    // set next syms according to CONFIG_DONGLE_SCREEN_SYSTEM (0,1,2)
+    uint8_t mods = 0;
+
+    for (int i = 0; i < MOD_STATUS_SLOTS; i++)
+    {
+        if (explicit_mod_counts[i] > 0)
+            mods |= BIT(i);
+    }
+
+    return mods;
+}
+
 #if CONFIG_DONGLE_SCREEN_SYSTEM_ICON == 1
-        syms[n++] = "󰌽"; // U+DF3D
+#define MOD_STATUS_GUI_SYMBOL "󰌽" // U+DF3D
 #elif CONFIG_DONGLE_SCREEN_SYSTEM_ICON == 2
-        syms[n++] = ""; // U+E62A
+#define MOD_STATUS_GUI_SYMBOL "" // U+E62A
 #else
-        syms[n++] = "󰘳"; // U+F0633
+#define MOD_STATUS_GUI_SYMBOL "󰘳" // U+F0633
 #endif
 
-    for (int i = 0; i < n; ++i)
+#define MOD_STATUS_FONT (&NerdFonts_Regular_20)
+#define MOD_STATUS_HEIGHT 40
+// Space between the left and the right modifiers
+#define MOD_STATUS_GROUP_GAP 20
+
+// One slot per modifier bit, the right hand modifiers mirror the left ones like on a keyboard
+static const struct
+{
+    const char *symbol;
+    uint8_t column;
+} mod_slots[MOD_STATUS_SLOTS] = {
+    [0] = {"󰘴", 0},                   // Left Ctrl
+    [1] = {"󰘶", 1},                   // Left Shift, U+F0636
+    [2] = {"󰘵", 2},                   // Left Alt, U+F0635
+    [3] = {MOD_STATUS_GUI_SYMBOL, 3}, // Left GUI
+    [4] = {"󰘴", 7},                   // Right Ctrl
+    [5] = {"󰘶", 6},                   // Right Shift
+    [6] = {"󰘵", 5},                   // Right Alt
+    [7] = {MOD_STATUS_GUI_SYMBOL, 4}, // Right GUI
+};
+
+// Only the slots whose bit flipped are touched, each invalidating its own fixed rectangle
+static void set_mod_symbols(struct zmk_widget_mod_status *widget, uint8_t changed, uint8_t mods)
+{
+    for (int i = 0; i < MOD_STATUS_SLOTS; i++)
     {
-        if (i > 0)
-            idx += snprintf(&text[idx], sizeof(text) - idx, " ");
-        idx += snprintf(&text[idx], sizeof(text) - idx, "%s", syms[i]);
+        if (!(changed & BIT(i)))
+            continue;
+
+        if (mods & BIT(i))
+            lv_obj_clear_flag(widget->slots[i], LV_OBJ_FLAG_HIDDEN);
+        else
+            lv_obj_add_flag(widget->slots[i], LV_OBJ_FLAG_HIDDEN);
     }
+}
+
+static void mod_status_update_cb(struct mod_status_state state)
+{
+    struct zmk_widget_mod_status *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
+    {
+        // Most key presses leave the modifiers alone, keep the slots untouched then
+        if (widget->mods == state.mods)
+        {
+            status_state_count_skipped();
+            continue;
+        }
 
-    lv_label_set_text(widget->label, idx ? text : "");
+        set_mod_symbols(widget, widget->mods ^ state.mods, state.mods);
+        widget->mods = state.mods;
+    }
 }
 
-static void mod_status_timer_cb(struct k_timer *timer)
+// Tracks the modifiers from the events themselves, the HID report may not be updated yet
+static struct mod_status_state mod_status_get_state(const zmk_event_t *eh)
 {
-    struct zmk_widget_mod_status *widget = k_timer_user_data_get(timer);
-    update_mod_status(widget);
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev != NULL)
+    {
+        if (is_mod(ev->usage_page, ev->keycode))
+        {
+            uint8_t *count = &explicit_mod_counts[ev->keycode - HID_USAGE_KEY_KEYBOARD_LEFTCONTROL];
+
+            if (ev->state)
+            {
+                *count += 1;
+            }
+            else if (*count > 0)
+            {
+                *count -= 1;
+            }
+        }
+        else if (ev->state)
+        {
+            implicit_mods = ev->implicit_modifiers;
+        }
+        else if (ev->implicit_modifiers)
+        {
+            implicit_mods = 0;
+        }
+    }
+
+    return (struct mod_status_state){
+        .mods = explicit_mods() | implicit_mods,
+    };
 }
 
-static struct k_timer mod_status_timer;
+STATUS_STATE_WIDGET_LISTENER(widget_mod_status, struct mod_status_state, mod_status_update_cb,
+                             mod_status_get_state)
+ZMK_SUBSCRIPTION(widget_mod_status, zmk_keycode_state_changed);
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 180, 40);
+    // Square slots as tall as a line of the font, so no glyph is clipped by its slot
+    int32_t slot_size = lv_font_get_line_height(MOD_STATUS_FONT);
+
+    // Without padding the eight slots and the gap fill the full width
+    widget->obj = status_container_create(parent);
+    lv_obj_set_size(widget->obj, MOD_STATUS_SLOTS * slot_size + MOD_STATUS_GROUP_GAP,
+                    LV_MAX(slot_size, MOD_STATUS_HEIGHT));
 
-    widget->label = lv_label_create(widget->obj);
-    lv_obj_align(widget->label, LV_ALIGN_CENTER, 0, 0);
-    lv_label_set_text(widget->label, "-");
-    lv_obj_set_style_text_font(widget->label, &NerdFonts_Regular_40, 0); // <-- NerdFont setzen
+    // All slots start hidden, matching no modifiers held
+    for (int i = 0; i < MOD_STATUS_SLOTS; i++)
+    {
+        uint8_t column = mod_slots[i].column;
+        int32_t x = column * slot_size + (column >= 4 ? MOD_STATUS_GROUP_GAP : 0);
+
+        widget->slots[i] = lv_label_create(widget->obj);
+        lv_obj_set_size(widget->slots[i], slot_size, slot_size);
+        lv_obj_align(widget->slots[i], LV_ALIGN_LEFT_MID, x, 0);
+        lv_obj_set_style_text_font(widget->slots[i], MOD_STATUS_FONT, 0); // <-- NerdFont setzen
+        lv_label_set_text_static(widget->slots[i], mod_slots[i].symbol);
+        lv_obj_add_flag(widget->slots[i], LV_OBJ_FLAG_HIDDEN);
+    }
 
-    k_timer_init(&mod_status_timer, mod_status_timer_cb, NULL);
-    k_timer_user_data_set(&mod_status_timer, widget);
-    k_timer_start(&mod_status_timer, K_MSEC(100), K_MSEC(100));
+    widget->mods = 0;
+    sys_slist_append(&widgets, &widget->node);
 
+    widget_mod_status_init();
     return 0;
 }
 
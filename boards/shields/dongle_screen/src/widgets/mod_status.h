@@ -3,11 +3,16 @@
 #include <lvgl.h>
 #include <zmk/display.h>
 
+#define MOD_STATUS_SLOTS 8
+
 struct zmk_widget_mod_status
 {
     sys_snode_t node;
     lv_obj_t *obj;
-    lv_obj_t *label;
+    // One icon per modifier bit of the HID report, left Ctrl to right GUI
+    lv_obj_t *slots[MOD_STATUS_SLOTS];
+    // Modifiers currently shown
+    uint8_t mods;
 };
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent);
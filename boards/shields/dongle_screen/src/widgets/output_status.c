@@ -19,6 +19,8 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/endpoints.h>
 
 #include "output_status.h"
+#include "../status_state.h"
+#include "../status_container.h"
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
@@ -91,17 +93,40 @@ static void set_status_symbol(struct zmk_widget_output_status *widget, struct ou
     lv_label_set_text(widget->ble_label, ble_text);
 }
 
+// State on the labels, all widgets show the same one
+static struct output_status_state shown;
+static bool shown_valid = false;
+
+static bool output_status_state_equal(struct output_status_state a, struct output_status_state b)
+{
+    return zmk_endpoint_instance_eq(a.selected_endpoint, b.selected_endpoint) &&
+           a.active_profile_index == b.active_profile_index &&
+           a.active_profile_connected == b.active_profile_connected &&
+           a.active_profile_bonded == b.active_profile_bonded &&
+           a.usb_is_hid_ready == b.usb_is_hid_ready;
+}
+
 static void output_status_update_cb(struct output_status_state state)
 {
+    // Repeated connection events leave the labels alone
+    if (shown_valid && output_status_state_equal(shown, state))
+    {
+        status_state_count_skipped();
+        return;
+    }
+
     struct zmk_widget_output_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
     {
         set_status_symbol(widget, state);
     }
+
+    shown = state;
+    shown_valid = true;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_output_status, struct output_status_state,
-                            output_status_update_cb, get_state)
+STATUS_STATE_WIDGET_LISTENER(widget_output_status, struct output_status_state,
+                             output_status_update_cb, get_state)
 ZMK_SUBSCRIPTION(widget_output_status, zmk_endpoint_changed);
 ZMK_SUBSCRIPTION(widget_output_status, zmk_ble_active_profile_changed);
 ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
@@ -109,7 +134,7 @@ ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
 // output_status.c
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
+    widget->obj = status_container_create(parent);
     lv_obj_set_size(widget->obj, 240, 77);
 
     widget->transport_label = lv_label_create(widget->obj);
@@ -120,6 +145,8 @@ int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_ob
 
     sys_slist_append(&widgets, &widget->node);
 
+    // The new labels are empty, draw them even if the state did not change
+    shown_valid = false;
     widget_output_status_init();
     return 0;
 }
@@ -14,6 +14,8 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/events/wpm_state_changed.h>
 
 #include "wpm_status.h"
+#include "../status_state.h"
+#include "../status_container.h"
 #include <fonts.h>
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
@@ -38,23 +40,35 @@ static void set_wpm(struct zmk_widget_wpm_status *widget, struct wpm_status_stat
     lv_label_set_text(widget->wpm_label, wpm_text);
 }
 
+// Value on the labels, all widgets show the same one
+static int shown_wpm = -1;
+
 static void wpm_status_update_cb(struct wpm_status_state state)
 {
+    // The WPM is reported periodically, mostly unchanged while idle
+    if (state.wpm == shown_wpm)
+    {
+        status_state_count_skipped();
+        return;
+    }
+
     struct zmk_widget_wpm_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
     {
         set_wpm(widget, state);
     }
+
+    shown_wpm = state.wpm;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state,
-                            wpm_status_update_cb, get_state)
+STATUS_STATE_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state,
+                             wpm_status_update_cb, get_state)
 ZMK_SUBSCRIPTION(widget_wpm_status, zmk_wpm_state_changed);
 
 // output_status.c
 int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
+    widget->obj = status_container_create(parent);
     lv_obj_set_size(widget->obj, 240, 77);
 
     widget->wpm_label = lv_label_create(widget->obj);
@@ -71,6 +85,8 @@ int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *p
 
     sys_slist_append(&widgets, &widget->node);
 
+    // The new label is empty, draw it even if the value did not change
+    shown_wpm = -1;
     widget_wpm_status_init();
     return 0;
 }
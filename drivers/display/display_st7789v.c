@@ -13,7 +13,10 @@
 
 #include "display_st7789v.h"
 
+#include <drivers/display/st7789v.h>
+
 #include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/mipi_dbi.h>
 #include <zephyr/pm/device.h>
 #include <zephyr/sys/byteorder.h>
@@ -26,32 +29,108 @@ LOG_MODULE_REGISTER(display_st7789v);
 struct st7789v_config {
 	const struct device *mipi_dbi;
 	const struct mipi_dbi_config dbi_config;
-	uint8_t vcom;
-	uint8_t gctrl;
-	bool vdv_vrh_enable;
-	uint8_t vrh_value;
-	uint8_t vdv_value;
+	const struct mipi_dbi_config dbi_config_seq;
 	uint8_t mdac;
-	uint8_t gamma;
 	uint8_t colmod;
-	uint8_t lcm;
-	bool inversion_on;
-	uint8_t porch_param[5];
-	uint8_t cmd2en_param[4];
-	uint8_t pwctrl1_param[2];
-	uint8_t pvgam_param[14];
-	uint8_t nvgam_param[14];
-	uint8_t ram_param[2];
-	uint8_t rgb_param[3];
+#ifdef CONFIG_ST7789V_TE_SYNC
+	struct gpio_dt_spec te_gpio;
+#endif
+	enum display_orientation orientation;
+	const uint8_t *init_cmds;
+	size_t init_cmds_len;
 	uint16_t height;
 	uint16_t width;
 	uint8_t ready_time_ms;
+	uint8_t *bounce_buf;
+#ifdef CONFIG_ST7789V_ROW_HASH
+	/* Hash per display row and column band of what the panel shows, 0 if unknown */
+	uint32_t *row_hash;
+	uint16_t row_hash_rows;
+#endif
+};
+
+/* Last column/row window programmed into the panel, in RAM coordinates */
+struct st7789v_window {
+	uint16_t x0;
+	uint16_t x1;
+	uint16_t y0;
+	uint16_t y1;
+	bool valid;
+};
+
+/* Scroll area in frame memory rows, len is 0 while no area is defined */
+struct st7789v_scroll {
+	uint16_t first;
+	uint16_t len;
+	bool flipped;
+};
+
+enum st7789v_init_state {
+	ST7789V_INIT_RESET,
+	ST7789V_INIT_CONFIGURE,
+	ST7789V_INIT_SLEEP_OUT,
+	ST7789V_INIT_DONE,
 };
 
 struct st7789v_data {
+	const struct device *dev;
 	uint16_t x_offset;
 	uint16_t y_offset;
 	enum display_orientation orientation;
+	uint8_t madctl;
+#ifdef CONFIG_ST7789V_RGB444
+	/* Pixels go out in the 12 bit interface mode */
+	bool rgb444;
+#endif
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	/* Format of the buffers passed to write, expanded through the palette */
+	enum display_pixel_format input_format;
+	/* RGB565 colours in panel byte order */
+	uint16_t palette[256];
+#endif
+	enum st7789v_init_state init_state;
+	int init_ret;
+	/* Serializes the API calls, protects the sleep state below */
+	struct k_mutex lock;
+	/* Panel is in sleep mode, writes are dropped and commands refused */
+	bool asleep;
+	/* Uptime at which the panel accepts commands again after SLPOUT */
+	int64_t awake_at;
+#ifdef CONFIG_PM_DEVICE
+	/* Blanking and frame rate requested while asleep, sent after wake-up */
+	bool defer_blanking;
+	bool blanked;
+	bool defer_rtna;
+	uint8_t rtna;
+#endif
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	struct k_work_delayable init_work;
+	struct k_sem ready;
+	/* Blanking switched off from the system work queue during the bring-up */
+	bool init_unblank;
+#endif
+	struct st7789v_window window;
+	struct st7789v_scroll scroll;
+	/* Number of pixel transfers used by the last write */
+	uint16_t flush_xfers;
+#ifdef CONFIG_ST7789V_TE_SYNC
+	struct gpio_callback te_cb;
+	struct k_sem te_sem;
+	/* The last write left the frame incomplete */
+	bool frame_open;
+#endif
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+	struct k_work xfer_work;
+	struct k_sem xfer_idle;
+	struct display_buffer_descriptor xfer_desc;
+	const void *xfer_buf;
+	uint16_t xfer_x;
+	uint16_t xfer_y;
+	int xfer_ret;
+#endif
+#ifdef CONFIG_ST7789V_STATS
+	struct st7789v_stats stats;
+#endif
 };
 
 #ifdef CONFIG_ST7789V_RGB888
@@ -60,6 +139,54 @@ struct st7789v_data {
 #define ST7789V_PIXEL_SIZE 2u
 #endif
 
+#ifdef CONFIG_ST7789V_RGB565
+#define ST7789V_NATIVE_FORMAT PIXEL_FORMAT_RGB_565
+#elif CONFIG_ST7789V_BGR565
+#define ST7789V_NATIVE_FORMAT PIXEL_FORMAT_BGR_565
+#else
+#define ST7789V_NATIVE_FORMAT PIXEL_FORMAT_RGB_888
+#endif
+
+#if defined(CONFIG_ST7789V_INPUT_MONO01)
+#define ST7789V_INPUT_FORMAT PIXEL_FORMAT_MONO01
+#elif defined(CONFIG_ST7789V_INPUT_MONO10)
+#define ST7789V_INPUT_FORMAT PIXEL_FORMAT_MONO10
+#elif defined(CONFIG_ST7789V_INPUT_L8)
+#define ST7789V_INPUT_FORMAT PIXEL_FORMAT_L_8
+#else
+#define ST7789V_INPUT_FORMAT ST7789V_NATIVE_FORMAT
+#endif
+
+#define ST7789V_INDEXED_FORMATS (PIXEL_FORMAT_MONO01 | PIXEL_FORMAT_MONO10 | PIXEL_FORMAT_L_8)
+
+/* A packed transfer must fit both the bounce buffer and the DMA length limit */
+#define ST7789V_BATCH_SIZE MIN(CONFIG_ST7789V_BOUNCE_BUFFER_SIZE, CONFIG_ST7789V_MAX_XFER_SIZE)
+
+#if CONFIG_ST7789V_BOUNCE_BUFFER_SIZE > 0
+#define ST7789V_BOUNCE_BUF_DEFINE(inst)							\
+	static uint8_t st7789v_bounce_buf_ ## inst[CONFIG_ST7789V_BOUNCE_BUFFER_SIZE] __aligned(4);
+#define ST7789V_BOUNCE_BUF_GET(inst) st7789v_bounce_buf_ ## inst
+#else
+#define ST7789V_BOUNCE_BUF_DEFINE(inst)
+#define ST7789V_BOUNCE_BUF_GET(inst) NULL
+#endif
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+/* Rows and columns swap with the orientation, size the table for either */
+#define ST7789V_ROW_HASH_ROWS(inst) MAX(DT_INST_PROP(inst, width), DT_INST_PROP(inst, height))
+#define ST7789V_ROW_HASH_DEFINE(inst)							\
+	static uint32_t st7789v_row_hash_ ## inst[ST7789V_ROW_HASH_ROWS(inst) *		\
+						  CONFIG_ST7789V_ROW_HASH_BANDS];
+#else
+#define ST7789V_ROW_HASH_DEFINE(inst)
+#endif
+
+#ifdef CONFIG_ST7789V_STATS
+#define ST7789V_STATS_ADD(data, field, n) ((data)->stats.field += (n))
+#else
+#define ST7789V_STATS_ADD(data, field, n) ((void)(data))
+#endif
+
 static void st7789v_set_lcd_margins(const struct device *dev,
 				    uint16_t x_offset, uint16_t y_offset)
 {
@@ -78,8 +205,34 @@ static int st7789v_transmit(const struct device *dev, uint8_t cmd,
 				      cmd, tx_data, tx_count);
 }
 
+/*
+ * Commands sent through dbi_config_seq keep the bus locked until
+ * st7789v_seq_end(), so a sequence is not split by other bus users.
+ */
+static int st7789v_seq_transmit(const struct device *dev, uint8_t cmd,
+				uint8_t *tx_data, size_t tx_count)
+{
+	const struct st7789v_config *config = dev->config;
+
+	return mipi_dbi_command_write(config->mipi_dbi, &config->dbi_config_seq,
+				      cmd, tx_data, tx_count);
+}
+
+static void st7789v_seq_end(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+
+	(void)mipi_dbi_release(config->mipi_dbi, &config->dbi_config_seq);
+}
+
+#ifdef CONFIG_PM_DEVICE
+/*
+ * Leave sleep mode without waiting for it. The next command waits out the
+ * rest of the 120 ms, so callers can overlap it with other work.
+ */
 static int st7789v_exit_sleep(const struct device *dev)
 {
+	struct st7789v_data *data = dev->data;
 	int ret;
 
 	ret = st7789v_transmit(dev, ST7789V_CMD_SLEEP_OUT, NULL, 0);
@@ -87,167 +240,1324 @@ static int st7789v_exit_sleep(const struct device *dev)
 		return ret;
 	}
 
-	k_sleep(K_MSEC(120));
+	data->awake_at = k_uptime_get() + 120;
+	data->asleep = false;
+	return ret;
+}
+
+static int st7789v_enter_sleep(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	ret = st7789v_transmit(dev, ST7789V_CMD_SLEEP_IN, NULL, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->asleep = true;
 	return ret;
 }
+#endif /* CONFIG_PM_DEVICE */
 
-static int st7789v_reset_display(const struct device *dev)
+/* Reset the panel, settle is set to the time it needs before the next command */
+static int st7789v_reset_display(const struct device *dev, k_timeout_t *settle)
 {
 	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
 	int ret;
 
 	LOG_DBG("Resetting display");
 
-	k_sleep(K_MSEC(1));
-	ret = mipi_dbi_reset(config->mipi_dbi, 6);
+	data->window.valid = false;
+
+	/* Shortest reset pulse of the datasheet, the settle time is waited out by the caller */
+	ret = mipi_dbi_reset(config->mipi_dbi, K_USEC(10));
 	if (ret == -ENOTSUP) {
 		/* Send software reset command */
 		ret = st7789v_transmit(dev, ST7789V_CMD_SW_RESET, NULL, 0);
 		if (ret < 0) {
 			return ret;
 		}
-		k_sleep(K_MSEC(5));
+		*settle = K_MSEC(5);
 	} else {
-		k_sleep(K_MSEC(20));
+		*settle = K_MSEC(20);
 	}
 
 	return ret;
 }
 
-static int st7789v_blanking_on(const struct device *dev)
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+static K_KERNEL_STACK_DEFINE(st7789v_xfer_stack, CONFIG_ST7789V_ASYNC_STACK_SIZE);
+static struct k_work_q st7789v_xfer_q;
+#endif
+
+/* Block until no pixel transfer is in flight, so commands are not interleaved with it */
+static void st7789v_wait_idle(const struct device *dev)
 {
-	return st7789v_transmit(dev, ST7789V_CMD_DISP_OFF, NULL, 0);
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+	struct st7789v_data *data = dev->data;
+
+	k_sem_take(&data->xfer_idle, K_FOREVER);
+	k_sem_give(&data->xfer_idle);
+#else
+	ARG_UNUSED(dev);
+#endif
 }
 
-static int st7789v_blanking_off(const struct device *dev)
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+/* The bring-up is still running on the system work queue, which is the caller */
+static bool st7789v_init_pending_here(const struct device *dev)
 {
-	return st7789v_transmit(dev, ST7789V_CMD_DISP_ON, NULL, 0);
+	struct st7789v_data *data = dev->data;
+
+	return data->init_state != ST7789V_INIT_DONE &&
+	       k_current_get() == k_work_queue_thread_get(&k_sys_work_q);
 }
+#endif
 
-static int st7789v_set_mem_area(const struct device *dev, const uint16_t x,
-				 const uint16_t y, const uint16_t w, const uint16_t h)
+/*
+ * Wait until the panel bring-up has finished, returns its result. Returns
+ * -EWOULDBLOCK on the system work queue, which runs the bring-up, and
+ * -EAGAIN if the bring-up takes longer than CONFIG_ST7789V_READY_TIMEOUT_MS.
+ */
+static int st7789v_wait_ready(const struct device *dev)
 {
 	struct st7789v_data *data = dev->data;
-	uint16_t spi_data[2];
 
-	uint16_t ram_x = x + data->x_offset;
-	uint16_t ram_y = y + data->y_offset;
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	if (data->init_state != ST7789V_INIT_DONE) {
+		if (st7789v_init_pending_here(dev)) {
+			return -EWOULDBLOCK;
+		}
+		if (k_sem_take(&data->ready, K_MSEC(CONFIG_ST7789V_READY_TIMEOUT_MS)) < 0) {
+			LOG_WRN("Display not ready after %d ms", CONFIG_ST7789V_READY_TIMEOUT_MS);
+			return -EAGAIN;
+		}
+		k_sem_give(&data->ready);
+	}
+#endif
+
+	return data->init_ret;
+}
 
+/* Wait for the panel and take the driver lock, which is only held on success */
+static int st7789v_lock(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
 	int ret;
 
-	spi_data[0] = sys_cpu_to_be16(ram_x);
-	spi_data[1] = sys_cpu_to_be16(ram_x + w - 1);
-	ret = st7789v_transmit(dev, ST7789V_CMD_CASET, (uint8_t *)&spi_data[0], 4);
+	ret = st7789v_wait_ready(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	spi_data[0] = sys_cpu_to_be16(ram_y);
-	spi_data[1] = sys_cpu_to_be16(ram_y + h - 1);
-	return st7789v_transmit(dev, ST7789V_CMD_RASET, (uint8_t *)&spi_data[0], 4);
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	return 0;
+}
+
+static void st7789v_unlock(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
+
+	k_mutex_unlock(&data->lock);
 }
 
-static int st7789v_write(const struct device *dev,
-			 const uint16_t x,
-			 const uint16_t y,
-			 const struct display_buffer_descriptor *desc,
-			 const void *buf)
+#ifdef CONFIG_PM_DEVICE
+/* Send the settings requested while the panel was asleep */
+static int st7789v_send_deferred(const struct device *dev)
 {
-	const struct st7789v_config *config = dev->config;
-	struct display_buffer_descriptor mipi_desc;
-	const uint8_t *write_data_start = (uint8_t *) buf;
-	uint16_t nbr_of_writes;
-	uint16_t write_h;
-	enum display_pixel_format pixfmt;
+	struct st7789v_data *data = dev->data;
 	int ret;
 
-	__ASSERT(desc->width <= desc->pitch, "Pitch is smaller than width");
-	__ASSERT((desc->pitch * ST7789V_PIXEL_SIZE * desc->height) <= desc->buf_size,
-			"Input buffer too small");
+	if (data->defer_blanking) {
+		ret = st7789v_transmit(dev, data->blanked ? ST7789V_CMD_DISP_OFF :
+				       ST7789V_CMD_DISP_ON, NULL, 0);
+		if (ret < 0) {
+			return ret;
+		}
+		data->defer_blanking = false;
+	}
 
-	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)",
-		desc->width, desc->height, x, y);
-	ret = st7789v_set_mem_area(dev, x, y, desc->width, desc->height);
+	if (data->defer_rtna) {
+		ret = st7789v_transmit(dev, ST7789V_CMD_FRCTRL2, &data->rtna, 1U);
+		if (ret < 0) {
+			return ret;
+		}
+		data->defer_rtna = false;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_PM_DEVICE */
+
+/*
+ * Make the panel ready for commands, called with the driver lock held.
+ * Returns -EBUSY while the panel sleeps. Otherwise waits for a transfer in
+ * flight and the end of the sleep-out delay.
+ */
+static int st7789v_awake(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
+
+	if (data->asleep) {
+		return -EBUSY;
+	}
+
+	st7789v_wait_idle(dev);
+
+	if (data->awake_at > k_uptime_get()) {
+		k_sleep(K_TIMEOUT_ABS_MS(data->awake_at));
+	}
+
+#ifdef CONFIG_PM_DEVICE
+	return st7789v_send_deferred(dev);
+#else
+	return 0;
+#endif
+}
+
+/* Send a command to the awake panel, returns -EBUSY while it sleeps */
+static int st7789v_command(const struct device *dev, uint8_t cmd,
+			   uint8_t *tx_data, size_t tx_count)
+{
+	int ret;
+
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	if (desc->pitch > desc->width) {
-		write_h = 1U;
-		nbr_of_writes = desc->height;
-		mipi_desc.height = 1;
-		mipi_desc.buf_size = desc->pitch * ST7789V_PIXEL_SIZE;
-	} else {
-		write_h = desc->height;
-		nbr_of_writes = 1U;
-		mipi_desc.height = desc->height;
-		mipi_desc.buf_size = desc->width * write_h * ST7789V_PIXEL_SIZE;
-	}
-	if (IS_ENABLED(CONFIG_ST7789V_RGB565)) {
-		pixfmt = PIXEL_FORMAT_RGB_565;
-	} else if (IS_ENABLED(CONFIG_ST7789V_BGR565)) {
-		pixfmt = PIXEL_FORMAT_BGR_565;
-	} else {
-		pixfmt = PIXEL_FORMAT_RGB_888;
+	ret = st7789v_awake(dev);
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, cmd, tx_data, tx_count);
 	}
 
-	mipi_desc.width = desc->width;
-	/* Per MIPI API, pitch must always match width */
-	mipi_desc.pitch = desc->width;
+	st7789v_unlock(dev);
 
-	/* Send RAMWR command */
-	ret = st7789v_transmit(dev, ST7789V_CMD_RAMWR, NULL, 0);
+	return ret;
+}
+
+static int st7789v_set_blanking(const struct device *dev, bool blank)
+{
+#if defined(CONFIG_PM_DEVICE) || defined(CONFIG_ST7789V_DEFERRED_INIT)
+	struct st7789v_data *data = dev->data;
+#endif
+	int ret;
+
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	if (st7789v_init_pending_here(dev)) {
+		/* Waiting would stall the bring-up, the display goes on at its end instead */
+		data->init_unblank = !blank;
+		return 0;
+	}
+#endif
+
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	for (uint16_t write_cnt = 0U; write_cnt < nbr_of_writes; ++write_cnt) {
-		ret = mipi_dbi_write_display(config->mipi_dbi, &config->dbi_config,
-					     write_data_start, &mipi_desc, pixfmt);
+	ret = st7789v_awake(dev);
+#ifdef CONFIG_PM_DEVICE
+	if (ret == -EBUSY) {
+		/* Sleep keeps the display on/off state, the change goes out after wake-up */
+		data->blanked = blank;
+		data->defer_blanking = true;
+		ret = 0;
+	} else
+#endif
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, blank ? ST7789V_CMD_DISP_OFF : ST7789V_CMD_DISP_ON,
+				       NULL, 0);
+	}
+
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+static int st7789v_blanking_on(const struct device *dev)
+{
+	return st7789v_set_blanking(dev, true);
+}
+
+static int st7789v_blanking_off(const struct device *dev)
+{
+	return st7789v_set_blanking(dev, false);
+}
+
+static int st7789v_set_mem_area(const struct device *dev, const uint16_t x,
+				 const uint16_t y, const uint16_t w, const uint16_t h)
+{
+	struct st7789v_data *data = dev->data;
+	struct st7789v_window *win = &data->window;
+	uint16_t spi_data[2];
+
+	uint16_t ram_x = x + data->x_offset;
+	uint16_t ram_y = y + data->y_offset;
+
+	int ret;
+
+	/* Widgets tend to redraw the same rectangle, skip what the panel already has */
+	if (!win->valid || win->x0 != ram_x || win->x1 != ram_x + w - 1) {
+		spi_data[0] = sys_cpu_to_be16(ram_x);
+		spi_data[1] = sys_cpu_to_be16(ram_x + w - 1);
+		ret = st7789v_seq_transmit(dev, ST7789V_CMD_CASET, (uint8_t *)&spi_data[0], 4);
 		if (ret < 0) {
 			return ret;
 		}
+		ST7789V_STATS_ADD(data, caset, 1U);
+	}
 
-		write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
+	if (!win->valid || win->y0 != ram_y || win->y1 != ram_y + h - 1) {
+		spi_data[0] = sys_cpu_to_be16(ram_y);
+		spi_data[1] = sys_cpu_to_be16(ram_y + h - 1);
+		ret = st7789v_seq_transmit(dev, ST7789V_CMD_RASET, (uint8_t *)&spi_data[0], 4);
+		if (ret < 0) {
+			return ret;
+		}
+		ST7789V_STATS_ADD(data, raset, 1U);
 	}
 
-	return ret;
+	win->x0 = ram_x;
+	win->x1 = ram_x + w - 1;
+	win->y0 = ram_y;
+	win->y1 = ram_y + h - 1;
+	win->valid = true;
+
+	return 0;
 }
 
-static void st7789v_get_capabilities(const struct device *dev,
-			      struct display_capabilities *capabilities)
+#ifdef CONFIG_ST7789V_ROW_HASH
+/* Forget what the panel shows, the next writes send every row */
+static void st7789v_row_hash_invalidate(const struct device *dev)
 {
 	const struct st7789v_config *config = dev->config;
-	const struct st7789v_data *data = dev->data;
 
-	memset(capabilities, 0, sizeof(struct display_capabilities));
+	memset(config->row_hash, 0,
+	       config->row_hash_rows * CONFIG_ST7789V_ROW_HASH_BANDS * sizeof(uint32_t));
+}
+
+/* Forget the bands of a rectangle written without hashing it */
+static void st7789v_row_hash_forget(const struct device *dev, uint16_t x, uint16_t y,
+				    uint16_t width, uint16_t height)
+{
+	const struct st7789v_config *config = dev->config;
+	const uint16_t band_w = DIV_ROUND_UP(config->row_hash_rows, CONFIG_ST7789V_ROW_HASH_BANDS);
+	const uint16_t band_first = MIN(x / band_w, CONFIG_ST7789V_ROW_HASH_BANDS - 1);
+	const uint16_t band_last = MIN((x + width - 1U) / band_w, CONFIG_ST7789V_ROW_HASH_BANDS - 1);
+
+	for (uint16_t row = y; row < y + height && row < config->row_hash_rows; row++) {
+		for (uint16_t band = band_first; band <= band_last; band++) {
+			config->row_hash[row * CONFIG_ST7789V_ROW_HASH_BANDS + band] = 0U;
+		}
+	}
+}
+#endif /* CONFIG_ST7789V_ROW_HASH */
+
+/* Rows of row_size bytes that can be packed into one bounce buffer transfer */
+static uint16_t st7789v_rows_per_batch(size_t row_size)
+{
+	return MAX(ST7789V_BATCH_SIZE / row_size, 1U);
+}
+
+#ifdef CONFIG_ST7789V_SWAP_RGB565
+/* Copy native RGB565 pixels into panel byte order, two pixels per 32 bit word */
+static void st7789v_swap_copy(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	if (IS_PTR_ALIGNED(dst, uint32_t) && IS_PTR_ALIGNED(src, uint32_t)) {
+		uint32_t *dst_word = (uint32_t *)dst;
+		const uint32_t *src_word = (const uint32_t *)src;
+
+		for (; len >= 4U; len -= 4U) {
+			uint32_t word = *src_word++;
+
+			*dst_word++ = ((word & 0x00ff00ffU) << 8) | ((word >> 8) & 0x00ff00ffU);
+		}
+
+		dst = (uint8_t *)dst_word;
+		src = (const uint8_t *)src_word;
+	}
+
+	for (; len >= 2U; len -= 2U) {
+		dst[0] = src[1];
+		dst[1] = src[0];
+		dst += 2;
+		src += 2;
+	}
+}
+#endif /* CONFIG_ST7789V_SWAP_RGB565 */
+
+/* Copy a row into the bounce buffer, in panel byte order */
+static inline void st7789v_copy_row(uint8_t *dst, const uint8_t *src, size_t len)
+{
+#ifdef CONFIG_ST7789V_SWAP_RGB565
+	st7789v_swap_copy(dst, src, len);
+#else
+	memcpy(dst, src, len);
+#endif
+}
+
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+/* Bytes per row of an indexed buffer, mono rows start on a byte boundary */
+static size_t st7789v_indexed_pitch(enum display_pixel_format format, uint16_t pitch)
+{
+	return format == PIXEL_FORMAT_L_8 ? pitch : DIV_ROUND_UP(pitch, 8U);
+}
+
+/* Expand a row of palette indices into RGB565 */
+static void st7789v_expand_row(const struct st7789v_data *data, uint8_t *dst,
+			       const uint8_t *src, uint16_t width)
+{
+	uint16_t *out = (uint16_t *)dst;
+
+	if (data->input_format == PIXEL_FORMAT_L_8) {
+		for (uint16_t col = 0U; col < width; col++) {
+			out[col] = data->palette[src[col]];
+		}
+		return;
+	}
+
+	/* MONO01 and MONO10 share the palette, MONO10 sets bits for black */
+	const uint8_t invert = data->input_format == PIXEL_FORMAT_MONO10 ? 1U : 0U;
+
+	for (uint16_t col = 0U; col < width; col++) {
+		uint8_t bit = (src[col >> 3] >> (7U - (col & 7U))) & 1U;
+
+		out[col] = data->palette[bit ^ invert];
+	}
+}
+
+/* Default palette for an input format: black and white, or a grey ramp */
+static void st7789v_default_palette(struct st7789v_data *data)
+{
+	if (data->input_format == PIXEL_FORMAT_L_8) {
+		for (uint16_t i = 0U; i < ARRAY_SIZE(data->palette); i++) {
+			uint16_t rgb565 = ((i >> 3) << 11) | ((i >> 2) << 5) | (i >> 3);
+
+			data->palette[i] = sys_cpu_to_be16(rgb565);
+		}
+	} else {
+		data->palette[0] = sys_cpu_to_be16(0x0000);
+		data->palette[1] = sys_cpu_to_be16(0xffff);
+	}
+}
+
+int st7789v_set_palette(const struct device *dev, const uint16_t *colors, size_t count)
+{
+	struct st7789v_data *data = dev->data;
+
+	int ret;
+
+	if (count > ARRAY_SIZE(data->palette)) {
+		return -EINVAL;
+	}
+
+	ret = st7789v_lock(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	st7789v_wait_idle(dev);
+
+	for (size_t i = 0U; i < count; i++) {
+		data->palette[i] = sys_cpu_to_be16(colors[i]);
+	}
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+	/* Same indices, different colours */
+	st7789v_row_hash_invalidate(dev);
+#endif
+
+	st7789v_unlock(dev);
+
+	return 0;
+}
+#endif /* CONFIG_ST7789V_INDEXED_INPUT */
+
+#ifdef CONFIG_ST7789V_RGB444
+/* Odd pixel of a window waiting for its partner from the next batch */
+struct st7789v_rgb444_carry {
+	uint16_t held;
+	bool pending;
+};
+
+/*
+ * Pack RGB565 rows into the 12 bit interface format, two pixels in three
+ * bytes. An odd pixel left over is kept in the carry for the next batch of
+ * the same window, so batches never end in the middle of a pixel pair.
+ * Returns the packed size.
+ */
+static size_t st7789v_pack_rgb444(uint8_t *dst, const uint8_t *src, size_t src_pitch,
+				  uint16_t width, uint16_t rows,
+				  struct st7789v_rgb444_carry *carry)
+{
+	uint8_t *out = dst;
+	uint16_t held = carry->held;
+	bool pending = carry->pending;
+
+	for (uint16_t row = 0U; row < rows; row++) {
+		const uint8_t *px = src + row * src_pitch;
+
+		for (uint16_t col = 0U; col < width; col++, px += 2) {
+			uint16_t rgb565 = IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565) ?
+					  sys_get_le16(px) : sys_get_be16(px);
+			uint16_t rgb444 = ((rgb565 >> 4) & 0xf00) | ((rgb565 >> 3) & 0x0f0) |
+					  ((rgb565 >> 1) & 0x00f);
+
+			if (!pending) {
+				held = rgb444;
+				pending = true;
+				continue;
+			}
+
+			*out++ = held >> 4;
+			*out++ = ((held & 0x0f) << 4) | (rgb444 >> 8);
+			*out++ = rgb444 & 0xff;
+			pending = false;
+		}
+	}
+
+	carry->held = held;
+	carry->pending = pending;
+
+	return out - dst;
+}
+
+/* Close a window with an odd pixel count, the last pixel goes out in two bytes */
+static size_t st7789v_pack_rgb444_tail(uint8_t *dst, struct st7789v_rgb444_carry *carry)
+{
+	if (!carry->pending) {
+		return 0U;
+	}
+
+	dst[0] = carry->held >> 4;
+	dst[1] = (carry->held & 0x0f) << 4;
+	carry->pending = false;
+
+	return 2U;
+}
+#endif /* CONFIG_ST7789V_RGB444 */
+
+#ifdef CONFIG_ST7789V_TE_SYNC
+static void st7789v_te_handler(const struct device *port, struct gpio_callback *cb,
+			       gpio_port_pins_t pins)
+{
+	struct st7789v_data *data = CONTAINER_OF(cb, struct st7789v_data, te_cb);
+
+	k_sem_give(&data->te_sem);
+}
+
+/* Hold the first write of a frame until the panel enters vertical blanking */
+static void st7789v_te_wait(const struct device *dev,
+			    const struct display_buffer_descriptor *desc)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+
+	if (config->te_gpio.port == NULL) {
+		return;
+	}
+
+	if (!data->frame_open) {
+		/* Only take the interrupt while waiting, TE toggles at the frame rate */
+		k_sem_reset(&data->te_sem);
+		gpio_pin_interrupt_configure_dt(&config->te_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+		if (k_sem_take(&data->te_sem, K_MSEC(CONFIG_ST7789V_TE_TIMEOUT_MS)) < 0) {
+			LOG_DBG("No TE edge, writing unsynchronized");
+		}
+		gpio_pin_interrupt_configure_dt(&config->te_gpio, GPIO_INT_DISABLE);
+	}
+
+	data->frame_open = desc->frame_incomplete;
+}
+
+static int st7789v_te_init(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	if (config->te_gpio.port == NULL) {
+		return 0;
+	}
+
+	if (!gpio_is_ready_dt(&config->te_gpio)) {
+		LOG_ERR("TE GPIO not ready");
+		return -ENODEV;
+	}
+
+	ret = gpio_pin_configure_dt(&config->te_gpio, GPIO_INPUT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_sem_init(&data->te_sem, 0, 1);
+	gpio_init_callback(&data->te_cb, st7789v_te_handler, BIT(config->te_gpio.pin));
+
+	return gpio_add_callback_dt(&config->te_gpio, &data->te_cb);
+}
+#endif /* CONFIG_ST7789V_TE_SYNC */
+
+#ifdef CONFIG_ST7789V_FILL
+/*
+ * Fill a window with one RGB565 colour (CPU byte order) within the current
+ * bus sequence, streaming the same pattern from the bounce buffer.
+ */
+static int st7789v_fill_seq(const struct device *dev, uint16_t x, uint16_t y,
+			    uint16_t width, uint16_t height, uint16_t color)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	struct display_buffer_descriptor mipi_desc;
+	size_t unit = ST7789V_PIXEL_SIZE;
+	size_t remaining = (size_t)width * height * ST7789V_PIXEL_SIZE;
+	size_t chunk;
+	uint16_t nbr_of_writes = 0U;
+	int ret;
+
+#ifdef CONFIG_ST7789V_RGB444
+	if (data->rgb444) {
+		/* Two pixels in three bytes, a trailing odd pixel in two */
+		uint16_t rgb444 = ((color >> 4) & 0xf00) | ((color >> 3) & 0x0f0) |
+				  ((color >> 1) & 0x00f);
+		uint8_t packed[3] = {
+			rgb444 >> 4,
+			((rgb444 & 0x0f) << 4) | (rgb444 >> 8),
+			rgb444 & 0xff,
+		};
+
+		unit = sizeof(packed);
+		remaining = DIV_ROUND_UP((size_t)width * height * 3U, 2U);
+		chunk = MIN(ROUND_DOWN(ST7789V_BATCH_SIZE, unit), ROUND_UP(remaining, unit));
+		for (size_t i = 0U; i < chunk; i += unit) {
+			memcpy(config->bounce_buf + i, packed, unit);
+		}
+	} else
+#endif
+	{
+		chunk = MIN(ROUND_DOWN(ST7789V_BATCH_SIZE, unit), remaining);
+		for (size_t i = 0U; i < chunk; i += unit) {
+			sys_put_be16(color, config->bounce_buf + i);
+		}
+	}
+
+	ret = st7789v_set_mem_area(dev, x, y, width, height);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = st7789v_seq_transmit(dev, ST7789V_CMD_RAMWR, NULL, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	mipi_desc.height = 1U;
+	while (remaining > 0U) {
+		mipi_desc.buf_size = MIN(chunk, remaining);
+		mipi_desc.width = mipi_desc.buf_size / unit;
+		mipi_desc.pitch = mipi_desc.width;
+
+		ret = mipi_dbi_write_display(config->mipi_dbi, &config->dbi_config_seq,
+					     config->bounce_buf, &mipi_desc, ST7789V_NATIVE_FORMAT);
+		if (ret < 0) {
+			return ret;
+		}
+		ST7789V_STATS_ADD(data, bytes, mipi_desc.buf_size);
+
+		remaining -= mipi_desc.buf_size;
+		nbr_of_writes++;
+	}
+
+	data->flush_xfers += nbr_of_writes;
+	ST7789V_STATS_ADD(data, transfers, nbr_of_writes);
+	ST7789V_STATS_ADD(data, pixels, (uint32_t)width * height);
+	LOG_DBG("Filled %dx%d with 0x%04x in %d transfer(s)", width, height, color,
+		nbr_of_writes);
+
+	return 0;
+}
+
+int st7789v_fill(const struct device *dev, uint16_t x, uint16_t y,
+		 uint16_t width, uint16_t height, uint16_t color)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	if (width == 0U || height == 0U) {
+		return 0;
+	}
+
+	ret = st7789v_lock(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = st7789v_awake(dev);
+	if (ret < 0) {
+		st7789v_unlock(dev);
+		return ret;
+	}
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+	st7789v_row_hash_forget(dev, x, y, width, height);
+#endif
+
+	data->flush_xfers = 0U;
+	ret = st7789v_fill_seq(dev, x, y, width, height, color);
+	st7789v_seq_end(dev);
+	if (ret < 0) {
+		data->window.valid = false;
+		ST7789V_STATS_ADD(data, errors, 1U);
+	}
+	ST7789V_STATS_ADD(data, fills, 1U);
+
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+/* Check whether all pixels of a 16 bit buffer match, color is set in CPU byte order */
+static bool st7789v_uniform_color(const struct display_buffer_descriptor *desc,
+				  const void *buf, uint16_t *color)
+{
+	const uint16_t *row = buf;
+	const uint16_t first = row[0];
+
+	for (uint16_t y = 0U; y < desc->height; y++, row += desc->pitch) {
+		for (uint16_t x = 0U; x < desc->width; x++) {
+			if (row[x] != first) {
+				return false;
+			}
+		}
+	}
+
+	*color = IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565) ? first : sys_be16_to_cpu(first);
+
+	return true;
+}
+#endif /* CONFIG_ST7789V_FILL */
+
+#ifdef CONFIG_ST7789V_STATS
+/* Account a finished write that took the given number of cycles */
+static void st7789v_stats_flush(struct st7789v_data *data, uint32_t cycles, int ret)
+{
+	struct st7789v_stats *stats = &data->stats;
+	const uint32_t us = k_cyc_to_us_floor32(cycles);
+	uint32_t ms = us / USEC_PER_MSEC;
+	uint8_t bucket = 0U;
+
+	stats->flushes++;
+	if (ret < 0) {
+		stats->errors++;
+	}
+
+	stats->busy_us += us;
+	stats->max_us = MAX(stats->max_us, us);
+
+	while (ms > 0U && bucket < ST7789V_STATS_LATENCY_BUCKETS - 1U) {
+		ms >>= 1;
+		bucket++;
+	}
+	stats->latency[bucket]++;
+}
+
+/*
+ * The counters change under the driver lock or on the transfer work queue, so
+ * holding the lock with no transfer in flight keeps them still. Does not wait
+ * for the bring-up, the counters are all zero until then.
+ */
+int st7789v_get_stats(const struct device *dev, struct st7789v_stats *stats)
+{
+	struct st7789v_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	st7789v_wait_idle(dev);
+	*stats = data->stats;
+	k_mutex_unlock(&data->lock);
+
+	return 0;
+}
+
+int st7789v_reset_stats(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	st7789v_wait_idle(dev);
+	memset(&data->stats, 0, sizeof(data->stats));
+	k_mutex_unlock(&data->lock);
+
+	return 0;
+}
+#endif /* CONFIG_ST7789V_STATS */
+
+/* Bytes per row of the buffers passed to write */
+static size_t st7789v_src_pitch(const struct st7789v_data *data, uint16_t pitch)
+{
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	if (data->input_format != ST7789V_NATIVE_FORMAT) {
+		return st7789v_indexed_pitch(data->input_format, pitch);
+	}
+#endif
+	return pitch * ST7789V_PIXEL_SIZE;
+}
+
+/*
+ * Send pixel data in transfers of at most CONFIG_ST7789V_MAX_XFER_SIZE bytes.
+ * Transfers are split on multiples of unit, so no pixel (pair) straddles two
+ * of them. Returns the number of transfers or a negative error code.
+ */
+static int st7789v_send_pixels(const struct device *dev, const uint8_t *buf, size_t len,
+			       size_t unit)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	const size_t max_len = ROUND_DOWN(CONFIG_ST7789V_MAX_XFER_SIZE, unit);
+	struct display_buffer_descriptor mipi_desc = {
+		.height = 1U,
+	};
+	int nbr_of_writes = 0;
+	int ret;
+
+	while (len > 0U) {
+		mipi_desc.buf_size = MIN(max_len, len);
+		/* Per MIPI API, pitch must always match width */
+		mipi_desc.width = DIV_ROUND_UP(mipi_desc.buf_size, unit);
+		mipi_desc.pitch = mipi_desc.width;
+
+		ret = mipi_dbi_write_display(config->mipi_dbi, &config->dbi_config_seq,
+					     buf, &mipi_desc, ST7789V_NATIVE_FORMAT);
+		if (ret < 0) {
+			return ret;
+		}
+		ST7789V_STATS_ADD(data, bytes, mipi_desc.buf_size);
+
+		buf += mipi_desc.buf_size;
+		len -= mipi_desc.buf_size;
+		nbr_of_writes++;
+	}
+
+	return nbr_of_writes;
+}
+
+/* Send a buffer to one window of the panel within the current bus sequence */
+static int st7789v_write_window(const struct device *dev,
+				const uint16_t x,
+				const uint16_t y,
+				const struct display_buffer_descriptor *desc,
+				const void *buf)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	const uint8_t *write_data_start = (uint8_t *) buf;
+	const size_t row_size = desc->width * ST7789V_PIXEL_SIZE;
+	const size_t src_pitch = st7789v_src_pitch(data, desc->pitch);
+	size_t unit = ST7789V_PIXEL_SIZE;
+	bool indexed = false;
+	uint16_t rows_per_write;
+	uint16_t write_h;
+	uint16_t nbr_of_writes = 0U;
+	int ret;
+#ifdef CONFIG_ST7789V_RGB444
+	struct st7789v_rgb444_carry carry = {0};
+#endif
+
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	indexed = data->input_format != ST7789V_NATIVE_FORMAT;
+#endif
+
+#ifdef CONFIG_ST7789V_FILL
+	/* Flat areas go out from a short repeated pattern, skipping any conversion */
+	if (!indexed) {
+		uint16_t color;
+
+		if (st7789v_uniform_color(desc, buf, &color)) {
+			return st7789v_fill_seq(dev, x, y, desc->width, desc->height, color);
+		}
+	}
+#endif
+
+	ret = st7789v_set_mem_area(dev, x, y, desc->width, desc->height);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (desc->pitch > desc->width || IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565) || indexed) {
+		/* Strided, swapped or indexed rows go through the bounce buffer, if there is one */
+		rows_per_write = st7789v_rows_per_batch(row_size);
+	} else {
+		rows_per_write = desc->height;
+	}
+	if ((IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565) || indexed) &&
+	    row_size > CONFIG_ST7789V_BOUNCE_BUFFER_SIZE) {
+		LOG_ERR("Row of %d pixels exceeds the bounce buffer", desc->width);
+		return -ENOMEM;
+	}
+#ifdef CONFIG_ST7789V_RGB444
+	if (data->rgb444) {
+		const size_t packed_row = DIV_ROUND_UP(desc->width * 3U, 2U);
+
+		/* Room for a pixel carried in from the previous batch and the closing tail */
+		if (packed_row + 3U > CONFIG_ST7789V_BOUNCE_BUFFER_SIZE) {
+			LOG_ERR("Row of %d pixels exceeds the bounce buffer", desc->width);
+			return -ENOMEM;
+		}
+
+		rows_per_write = MAX((CONFIG_ST7789V_BOUNCE_BUFFER_SIZE - 3U) / packed_row, 1U);
+		/* Transfers carry whole pixel pairs, only the last one may end in a tail */
+		unit = 3U;
+	}
+#endif
+
+	/* Send RAMWR command */
+	ret = st7789v_seq_transmit(dev, ST7789V_CMD_RAMWR, NULL, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (uint16_t row = 0U; row < desc->height; row += write_h) {
+		const uint8_t *src = write_data_start + row * src_pitch;
+
+		size_t len;
+
+		write_h = MIN(rows_per_write, desc->height - row);
+		len = row_size * write_h;
+
+#ifdef CONFIG_ST7789V_RGB444
+		if (data->rgb444) {
+			len = st7789v_pack_rgb444(config->bounce_buf, src, src_pitch,
+						  desc->width, write_h, &carry);
+			if (row + write_h == desc->height) {
+				len += st7789v_pack_rgb444_tail(config->bounce_buf + len, &carry);
+			}
+			src = config->bounce_buf;
+		} else
+#endif
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+		if (indexed) {
+			for (uint16_t i = 0U; i < write_h; i++) {
+				st7789v_expand_row(data, config->bounce_buf + i * row_size,
+						   src + i * src_pitch, desc->width);
+			}
+			src = config->bounce_buf;
+		} else
+#endif
+		if ((write_h > 1U && desc->pitch > desc->width) ||
+		    IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565)) {
+			for (uint16_t i = 0U; i < write_h; i++) {
+				st7789v_copy_row(config->bounce_buf + i * row_size,
+						 src + i * src_pitch, row_size);
+			}
+			src = config->bounce_buf;
+		}
+
+		ret = st7789v_send_pixels(dev, src, len, unit);
+		if (ret < 0) {
+			return ret;
+		}
+
+		nbr_of_writes += ret;
+	}
+
+	data->flush_xfers += nbr_of_writes;
+	ST7789V_STATS_ADD(data, transfers, nbr_of_writes);
+	ST7789V_STATS_ADD(data, pixels, (uint32_t)desc->width * desc->height);
+	LOG_DBG("Flushed %dx%d in %d transfer(s)", desc->width, desc->height, nbr_of_writes);
+
+	return 0;
+}
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+/* FNV-1a over a column span of a source row, seeded with the span */
+static uint32_t st7789v_row_hash(const uint8_t *src, size_t len, uint16_t x0, uint16_t x1)
+{
+	uint32_t hash = 2166136261U ^ ((uint32_t)x0 << 16 | x1);
+
+	for (size_t i = 0U; i < len; i++) {
+		hash = (hash ^ src[i]) * 16777619U;
+	}
+
+	/* 0 marks unknown content */
+	return hash != 0U ? hash : 1U;
+}
+
+/* Byte span of source row pixels x0 to x1 */
+static void st7789v_src_span(const struct st7789v_data *data, uint16_t x0, uint16_t x1,
+			     size_t *first, size_t *len)
+{
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	if (data->input_format == PIXEL_FORMAT_L_8) {
+		*first = x0;
+		*len = x1 - x0 + 1U;
+		return;
+	} else if (data->input_format != ST7789V_NATIVE_FORMAT) {
+		/* Neighbouring pixels sharing a byte only make the span look dirty more often */
+		*first = x0 / 8U;
+		*len = x1 / 8U - *first + 1U;
+		return;
+	}
+#endif
+	*first = x0 * ST7789V_PIXEL_SIZE;
+	*len = (x1 - x0 + 1U) * ST7789V_PIXEL_SIZE;
+}
+
+/*
+ * Update the hashes of one source row and check whether the panel already
+ * shows it. Each band keeps the hash of the span last written to it, so a
+ * match means no write has changed those pixels since.
+ */
+static bool st7789v_row_changed(const struct device *dev, uint16_t x, uint16_t y,
+				uint16_t width, const uint8_t *src)
+{
+	const struct st7789v_config *config = dev->config;
+	const struct st7789v_data *data = dev->data;
+	const uint16_t band_w = DIV_ROUND_UP(config->row_hash_rows, CONFIG_ST7789V_ROW_HASH_BANDS);
+	const uint16_t x_end = x + width - 1U;
+	uint32_t *hashes;
+	bool changed = false;
+
+	if (y >= config->row_hash_rows || x_end >= config->row_hash_rows) {
+		return true;
+	}
+
+	hashes = &config->row_hash[y * CONFIG_ST7789V_ROW_HASH_BANDS];
+	for (uint16_t band = x / band_w; band <= x_end / band_w; band++) {
+		const uint16_t x0 = MAX(x, band * band_w);
+		const uint16_t x1 = MIN(x_end, (band + 1U) * band_w - 1U);
+		size_t first;
+		size_t len;
+		uint32_t hash;
+
+		st7789v_src_span(data, x0 - x, x1 - x, &first, &len);
+		hash = st7789v_row_hash(src + first, len, x0, x1);
+		if (hashes[band] != hash) {
+			hashes[band] = hash;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+/* Send only the runs of rows that differ from what the panel shows */
+static int st7789v_write_changed_rows(const struct device *dev,
+				      const uint16_t x,
+				      const uint16_t y,
+				      const struct display_buffer_descriptor *desc,
+				      const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+	const size_t src_pitch = st7789v_src_pitch(data, desc->pitch);
+	const uint8_t *src = buf;
+	struct display_buffer_descriptor run_desc = *desc;
+	uint16_t run_start = 0U;
+	uint16_t run_len = 0U;
+	int ret;
+
+	for (uint16_t row = 0U; row <= desc->height; row++) {
+		if (row < desc->height &&
+		    st7789v_row_changed(dev, x, y + row, desc->width, src + row * src_pitch)) {
+			if (run_len++ == 0U) {
+				run_start = row;
+			}
+			continue;
+		}
+
+		if (row < desc->height) {
+			ST7789V_STATS_ADD(data, rows_skipped, 1U);
+		}
+
+		if (run_len == 0U) {
+			continue;
+		}
+
+		run_desc.height = run_len;
+		run_desc.buf_size = src_pitch * run_len;
+		ret = st7789v_write_window(dev, x, y + run_start,
+					   &run_desc, src + run_start * src_pitch);
+		if (ret < 0) {
+			/* Part of the rows may have reached the panel */
+			st7789v_row_hash_forget(dev, x, y, desc->width, desc->height);
+			return ret;
+		}
+		run_len = 0U;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_ST7789V_ROW_HASH */
+
+static int st7789v_write_seq(const struct device *dev,
+			     const uint16_t x,
+			     const uint16_t y,
+			     const struct display_buffer_descriptor *desc,
+			     const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+
+	__ASSERT(desc->width <= desc->pitch, "Pitch is smaller than width");
+	/* The last row may end at the end of the buffer instead of a full pitch later */
+	__ASSERT(desc->height == 0U ||
+		 (st7789v_src_pitch(data, desc->pitch) * (desc->height - 1U) +
+		  st7789v_src_pitch(data, desc->width)) <= desc->buf_size,
+		 "Input buffer too small");
+
+	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)",
+		desc->width, desc->height, x, y);
+
+	data->flush_xfers = 0U;
+
+#ifdef CONFIG_ST7789V_TE_SYNC
+	st7789v_te_wait(dev, desc);
+#endif
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+	return st7789v_write_changed_rows(dev, x, y, desc, buf);
+#else
+	return st7789v_write_window(dev, x, y, desc, buf);
+#endif
+}
+
+static int st7789v_write_sync(const struct device *dev,
+			 const uint16_t x,
+			 const uint16_t y,
+			 const struct display_buffer_descriptor *desc,
+			 const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+#ifdef CONFIG_ST7789V_STATS
+	const uint32_t start = k_cycle_get_32();
+#endif
+	int ret;
+
+	ret = st7789v_write_seq(dev, x, y, desc, buf);
+	st7789v_seq_end(dev);
+	if (ret < 0) {
+		/* The panel may hold a partially programmed window */
+		data->window.valid = false;
+	}
+
+#ifdef CONFIG_ST7789V_STATS
+	st7789v_stats_flush(data, k_cycle_get_32() - start, ret);
+#endif
+
+	return ret;
+}
+
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+static void st7789v_xfer_work_handler(struct k_work *work)
+{
+	struct st7789v_data *data = CONTAINER_OF(work, struct st7789v_data, xfer_work);
+
+	data->xfer_ret = st7789v_write_sync(data->dev, data->xfer_x, data->xfer_y,
+					    &data->xfer_desc, data->xfer_buf);
+	k_sem_give(&data->xfer_idle);
+}
+
+/*
+ * Queue the transfer and return while it is on the wire. The caller must not
+ * touch buf until the next write returns, which holds with two render buffers
+ * used alternately. A failed transfer is reported by the following call.
+ */
+static int st7789v_write_async(const struct device *dev,
+			       const uint16_t x,
+			       const uint16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	k_sem_take(&data->xfer_idle, K_FOREVER);
+
+	ret = data->xfer_ret;
+	data->xfer_ret = 0;
+	if (ret < 0) {
+		LOG_ERR("Previous transfer failed (%d)", ret);
+	}
+
+	data->xfer_x = x;
+	data->xfer_y = y;
+	data->xfer_desc = *desc;
+	data->xfer_buf = buf;
+	k_work_submit_to_queue(&st7789v_xfer_q, &data->xfer_work);
+
+	return ret;
+}
+
+static void st7789v_async_init(const struct device *dev)
+{
+	static bool xfer_q_started;
+	struct st7789v_data *data = dev->data;
+
+	if (!xfer_q_started) {
+		const struct k_work_queue_config cfg = {
+			.name = "st7789v_xfer",
+		};
+
+		k_work_queue_start(&st7789v_xfer_q, st7789v_xfer_stack,
+				   K_KERNEL_STACK_SIZEOF(st7789v_xfer_stack),
+				   CONFIG_ST7789V_ASYNC_THREAD_PRIORITY, &cfg);
+		xfer_q_started = true;
+	}
+
+	data->xfer_ret = 0;
+	k_work_init(&data->xfer_work, st7789v_xfer_work_handler);
+	k_sem_init(&data->xfer_idle, 1, 1);
+}
+#endif /* CONFIG_ST7789V_ASYNC_WRITE */
+
+static int st7789v_write(const struct device *dev,
+			 const uint16_t x,
+			 const uint16_t y,
+			 const struct display_buffer_descriptor *desc,
+			 const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	/* An empty area would wrap the window end address */
+	if (desc->width == 0U || desc->height == 0U) {
+		return 0;
+	}
+
+	ret = st7789v_lock(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = st7789v_awake(dev);
+	if (ret == -EBUSY) {
+		/* Nothing is shown while asleep, the caller redraws after resume */
+		LOG_DBG("Panel asleep, dropping write");
+		data->window.valid = false;
+		ST7789V_STATS_ADD(data, dropped, 1U);
+		ret = 0;
+	} else if (ret == 0) {
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+		ret = st7789v_write_async(dev, x, y, desc, buf);
+#else
+		ret = st7789v_write_sync(dev, x, y, desc, buf);
+#endif
+	}
+
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+static void st7789v_get_capabilities(const struct device *dev,
+			      struct display_capabilities *capabilities)
+{
+	const struct st7789v_config *config = dev->config;
+	const struct st7789v_data *data = dev->data;
+
+	memset(capabilities, 0, sizeof(struct display_capabilities));
+
+	/* Swap dimensions for 90° and 270° rotations (MV bit swaps axes) */
+	if (data->orientation == DISPLAY_ORIENTATION_ROTATED_90 ||
+	    data->orientation == DISPLAY_ORIENTATION_ROTATED_270) {
+		capabilities->x_resolution = config->height;
+		capabilities->y_resolution = config->width;
+	} else {
+		capabilities->x_resolution = config->width;
+		capabilities->y_resolution = config->height;
+	}
+
+#ifdef CONFIG_ST7789V_RGB565
+	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_565;
+	capabilities->current_pixel_format = PIXEL_FORMAT_RGB_565;
+#elif CONFIG_ST7789V_BGR565
+	capabilities->supported_pixel_formats = PIXEL_FORMAT_BGR_565;
+	capabilities->current_pixel_format = PIXEL_FORMAT_BGR_565;
+#else
+	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_888;
+	capabilities->current_pixel_format = PIXEL_FORMAT_RGB_888;
+#endif
+#ifdef CONFIG_ST7789V_RGB444
+	/* Only the interface format changes, buffers keep the format above */
+	capabilities->supported_pixel_formats |= PIXEL_FORMAT_ST7789V_RGB_444;
+#endif
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	capabilities->supported_pixel_formats |= ST7789V_INDEXED_FORMATS;
+	capabilities->current_pixel_format = data->input_format;
+	capabilities->screen_info = SCREEN_INFO_MONO_MSB_FIRST;
+#endif
+	capabilities->current_orientation = data->orientation;
+}
+
+#ifdef CONFIG_ST7789V_RGB444
+/* Switch the interface between the 16 bit and 12 bit modes */
+static int st7789v_set_rgb444(const struct device *dev, bool enable)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint8_t colmod = config->colmod;
+	int ret;
+
+	if (enable) {
+		colmod = (colmod & 0xf0) | ST7789V_COLMOD_FMT_12bit;
+	}
+
+	ret = st7789v_lock(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = st7789v_awake(dev);
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, ST7789V_CMD_COLMOD, &colmod, 1U);
+	}
+	if (ret == 0) {
+		data->rgb444 = enable;
+	}
 
-	/* Swap dimensions for 90° and 270° rotations (MV bit swaps axes) */
-	if (data->orientation == DISPLAY_ORIENTATION_ROTATED_90 ||
-	    data->orientation == DISPLAY_ORIENTATION_ROTATED_270) {
-		capabilities->x_resolution = config->height;
-		capabilities->y_resolution = config->width;
-	} else {
-		capabilities->x_resolution = config->width;
-		capabilities->y_resolution = config->height;
+	st7789v_unlock(dev);
+	if (ret < 0) {
+		return ret;
 	}
 
-#ifdef CONFIG_ST7789V_RGB565
-	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_565;
-	capabilities->current_pixel_format = PIXEL_FORMAT_RGB_565;
-#elif CONFIG_ST7789V_BGR565
-	capabilities->supported_pixel_formats = PIXEL_FORMAT_BGR_565;
-	capabilities->current_pixel_format = PIXEL_FORMAT_BGR_565;
-#else
-	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_888;
-	capabilities->current_pixel_format = PIXEL_FORMAT_RGB_888;
-#endif
-	capabilities->current_orientation = data->orientation;
+	LOG_DBG("Interface mode %d bit", enable ? 12 : 16);
+
+	return 0;
 }
+#endif /* CONFIG_ST7789V_RGB444 */
 
 static int st7789v_set_pixel_format(const struct device *dev,
 			     const enum display_pixel_format pixel_format)
 {
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	struct st7789v_data *data = dev->data;
+
+	if (pixel_format == ST7789V_NATIVE_FORMAT ||
+	    (pixel_format & ST7789V_INDEXED_FORMATS) != 0) {
+		int ret = st7789v_lock(dev);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		st7789v_wait_idle(dev);
+		if (pixel_format != data->input_format) {
+			data->input_format = pixel_format;
+			st7789v_default_palette(data);
+#ifdef CONFIG_ST7789V_ROW_HASH
+			st7789v_row_hash_invalidate(dev);
+#endif
+		}
+
+		st7789v_unlock(dev);
+		return 0;
+	}
+#endif
+#ifdef CONFIG_ST7789V_RGB444
+	if (pixel_format == PIXEL_FORMAT_ST7789V_RGB_444) {
+		return st7789v_set_rgb444(dev, true);
+	}
+#endif
 #ifdef CONFIG_ST7789V_RGB565
 	if (pixel_format == PIXEL_FORMAT_RGB_565) {
 #elif CONFIG_ST7789V_BGR565
@@ -255,18 +1565,23 @@ static int st7789v_set_pixel_format(const struct device *dev,
 #else
 	if (pixel_format == PIXEL_FORMAT_RGB_888) {
 #endif
+#ifdef CONFIG_ST7789V_RGB444
+		return st7789v_set_rgb444(dev, false);
+#else
 		return 0;
+#endif
 	}
 	LOG_ERR("Pixel format change not implemented");
 	return -ENOTSUP;
 }
 
-static int st7789v_set_orientation(const struct device *dev,
-				   const enum display_orientation orientation)
+/* Compute the MADCTL value for an orientation and move the margins along */
+static int st7789v_orientation_madctl(const struct device *dev,
+				      const enum display_orientation orientation,
+				      uint8_t *madctl)
 {
 	const struct st7789v_config *config = dev->config;
 	struct st7789v_data *data = dev->data;
-	int ret;
 
 	/* only modifying the MY, MX, MV bits, keep existing MDAC config */
 	uint8_t tx_data = config->mdac & (ST7789V_MADCTL_ML | ST7789V_MADCTL_BGR |
@@ -312,158 +1627,414 @@ static int st7789v_set_orientation(const struct device *dev,
 	}
 
 	st7789v_set_lcd_margins(dev, x_offset, y_offset);
-	ret = st7789v_transmit(dev, ST7789V_CMD_MADCTL, &tx_data, 1U);
-	if (ret < 0) {
-		return ret;
-	}
+	data->window.valid = false;
+	data->scroll.len = 0;
 	data->orientation = orientation;
-	LOG_INF("Changed orientation to: '%d'", data->orientation);
+	data->madctl = tx_data;
+	*madctl = tx_data;
 
 	return 0;
 }
 
-static int st7789v_lcd_init(const struct device *dev)
+static int st7789v_set_orientation(const struct device *dev,
+				   const enum display_orientation orientation)
 {
 	struct st7789v_data *data = dev->data;
-	const struct st7789v_config *config = dev->config;
-	uint8_t tmp;
+	uint8_t tx_data;
 	int ret;
 
-	st7789v_set_lcd_margins(dev, data->x_offset,
-				data->y_offset);
-
-	ret = st7789v_transmit(dev, ST7789V_CMD_CMD2EN,
-			       (uint8_t *)config->cmd2en_param,
-			       sizeof(config->cmd2en_param));
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_PORCTRL,
-			       (uint8_t *)config->porch_param,
-			       sizeof(config->porch_param));
-	if (ret < 0) {
-		return ret;
+	ret = st7789v_awake(dev);
+	if (ret == 0) {
+		ret = st7789v_orientation_madctl(dev, orientation, &tx_data);
+	}
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, ST7789V_CMD_MADCTL, &tx_data, 1U);
+	}
+	if (ret == 0) {
+		LOG_INF("Changed orientation to: '%d'", data->orientation);
+#ifdef CONFIG_ST7789V_ROW_HASH
+		/* Display rows now land elsewhere in frame memory */
+		st7789v_row_hash_invalidate(dev);
+#endif
 	}
 
-	/* Digital Gamma Enable, default disabled */
-	tmp = 0x00;
-	ret = st7789v_transmit(dev, ST7789V_CMD_DGMEN, &tmp, 1);
-	if (ret < 0) {
-		return ret;
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+/*
+ * Map a band of display lines onto frame memory rows. flipped is set when MY
+ * counts the rows from the bottom, reversing the band.
+ */
+static int st7789v_map_band(const struct device *dev, uint16_t start, uint16_t len,
+			    uint16_t *first, bool *flipped)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+
+	/* The panel rows span y, or x when MV swaps the axes */
+	if (len == 0 || start + len > config->height) {
+		LOG_ERR("Band %u+%u exceeds %u lines", start, len, config->height);
+		return -EINVAL;
 	}
 
-	/* Frame Rate Control in Normal Mode, default value */
-	tmp = 0x0f;
-	ret = st7789v_transmit(dev, ST7789V_CMD_FRCTRL2, &tmp, 1);
-	if (ret < 0) {
-		return ret;
+	switch (data->orientation) {
+	case DISPLAY_ORIENTATION_NORMAL:
+		*first = data->y_offset + start;
+		*flipped = false;
+		break;
+	case DISPLAY_ORIENTATION_ROTATED_90:
+		*first = ST7789V_GRAM_ROWS - (data->x_offset + start + len);
+		*flipped = true;
+		break;
+	case DISPLAY_ORIENTATION_ROTATED_180:
+		*first = ST7789V_GRAM_ROWS - (data->y_offset + start + len);
+		*flipped = true;
+		break;
+	case DISPLAY_ORIENTATION_ROTATED_270:
+		*first = data->x_offset + start;
+		*flipped = false;
+		break;
+	default:
+		return -ENOTSUP;
 	}
 
-	tmp = config->gctrl;
-	ret = st7789v_transmit(dev, ST7789V_CMD_GCTRL, &tmp, 1);
+	return 0;
+}
+
+static int st7789v_partial_area_seq(const struct device *dev, uint16_t start, uint16_t len)
+{
+	uint16_t first;
+	bool flipped;
+	uint8_t tx_data[4];
+	int ret;
+
+	if (len == 0) {
+		return st7789v_transmit(dev, ST7789V_CMD_NORON, NULL, 0);
+	}
+
+	ret = st7789v_map_band(dev, start, len, &first, &flipped);
 	if (ret < 0) {
 		return ret;
 	}
 
-	tmp = config->vcom;
-	ret = st7789v_transmit(dev, ST7789V_CMD_VCOMS, &tmp, 1);
+	sys_put_be16(first, &tx_data[0]);
+	sys_put_be16(first + len - 1, &tx_data[2]);
+
+	ret = st7789v_seq_transmit(dev, ST7789V_CMD_PTLAR, tx_data, sizeof(tx_data));
+	if (ret == 0) {
+		ret = st7789v_seq_transmit(dev, ST7789V_CMD_PTLON, NULL, 0);
+	}
+	st7789v_seq_end(dev);
+
+	return ret;
+}
+
+int st7789v_set_partial_area(const struct device *dev, uint16_t start, uint16_t len)
+{
+	int ret;
+
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	if (config->vdv_vrh_enable) {
-		tmp = 0x01;
-		ret = st7789v_transmit(dev, ST7789V_CMD_VDVVRHEN, &tmp, 1);
-		if (ret < 0) {
-			return ret;
-		}
+	ret = st7789v_awake(dev);
+	if (ret == 0) {
+		ret = st7789v_partial_area_seq(dev, start, len);
+	}
 
-		tmp = config->vrh_value;
-		ret = st7789v_transmit(dev, ST7789V_CMD_VRH, &tmp, 1);
-		if (ret < 0) {
-			return ret;
-		}
+	st7789v_unlock(dev);
 
-		tmp = config->vdv_value;
-		ret = st7789v_transmit(dev, ST7789V_CMD_VDS, &tmp, 1);
+	return ret;
+}
+
+static int st7789v_scroll_area_seq(const struct device *dev, uint16_t start, uint16_t len)
+{
+	struct st7789v_data *data = dev->data;
+	uint16_t first = 0;
+	bool flipped = false;
+	uint8_t tx_data[6];
+	int ret;
+
+	if (len == 0) {
+		/* Scroll the whole frame memory, which at offset 0 shows it unscrolled */
+		len = ST7789V_GRAM_ROWS;
+	} else {
+		ret = st7789v_map_band(dev, start, len, &first, &flipped);
 		if (ret < 0) {
 			return ret;
 		}
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_PWCTRL1,
-			       (uint8_t *)config->pwctrl1_param,
-			       sizeof(config->pwctrl1_param));
+	/* Top fixed area, scroll area and bottom fixed area add up to the frame memory */
+	sys_put_be16(first, &tx_data[0]);
+	sys_put_be16(len, &tx_data[2]);
+	sys_put_be16(ST7789V_GRAM_ROWS - first - len, &tx_data[4]);
+
+	ret = st7789v_seq_transmit(dev, ST7789V_CMD_VSCRDEF, tx_data, sizeof(tx_data));
+	if (ret == 0) {
+		sys_put_be16(first, &tx_data[0]);
+		ret = st7789v_seq_transmit(dev, ST7789V_CMD_VSCSAD, tx_data, 2U);
+	}
+	st7789v_seq_end(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	/* Memory Data Access Control */
-	tmp = config->mdac;
-	ret = st7789v_transmit(dev, ST7789V_CMD_MADCTL, &tmp, 1);
+	data->scroll.first = first;
+	data->scroll.len = len;
+	data->scroll.flipped = flipped;
+
+	return 0;
+}
+
+int st7789v_set_scroll_area(const struct device *dev, uint16_t start, uint16_t len)
+{
+	int ret;
+
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	/* Interface Pixel Format */
-	tmp = config->colmod;
-	ret = st7789v_transmit(dev, ST7789V_CMD_COLMOD, &tmp, 1);
-	if (ret < 0) {
-		return ret;
+	ret = st7789v_awake(dev);
+	if (ret == 0) {
+		ret = st7789v_scroll_area_seq(dev, start, len);
 	}
 
-	tmp = config->lcm;
-	ret = st7789v_transmit(dev, ST7789V_CMD_LCMCTRL, &tmp, 1);
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+int st7789v_set_scroll_offset(const struct device *dev, uint16_t offset)
+{
+	struct st7789v_data *data = dev->data;
+	uint8_t tx_data[2];
+	int ret;
+
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	tmp = config->gamma;
-	ret = st7789v_transmit(dev, ST7789V_CMD_GAMSET, &tmp, 1);
-	if (ret < 0) {
-		return ret;
+	ret = st7789v_awake(dev);
+	if (ret == 0 && data->scroll.len == 0) {
+		ret = -EINVAL;
 	}
+	if (ret == 0) {
+		/* Frame memory line shown first in the scroll area, reversed under MY */
+		offset %= data->scroll.len;
+		if (data->scroll.flipped && offset != 0) {
+			offset = data->scroll.len - offset;
+		}
 
-	if (config->inversion_on) {
-		ret = st7789v_transmit(dev, ST7789V_CMD_INV_ON, NULL, 0);
-	} else {
-		ret = st7789v_transmit(dev, ST7789V_CMD_INV_OFF, NULL, 0);
+		sys_put_be16(data->scroll.first + offset, tx_data);
+		ret = st7789v_transmit(dev, ST7789V_CMD_VSCSAD, tx_data, sizeof(tx_data));
 	}
-	if (ret < 0) {
-		return ret;
+
+	st7789v_unlock(dev);
+
+	return ret;
+}
+
+/* Normal mode frame rate in Hz for each FRCTRL2 RTNA setting, default porches */
+static const uint8_t st7789v_frame_rates[] = {
+	119, 111, 105, 99, 94, 90, 86, 82, 78, 75, 72, 69, 67, 64, 62, 60,
+	58, 57, 55, 53, 52, 50, 49, 48, 46, 45, 44, 43, 42, 41, 40, 39,
+};
+
+int st7789v_set_frame_rate(const struct device *dev, uint8_t hz)
+{
+#ifdef CONFIG_PM_DEVICE
+	struct st7789v_data *data = dev->data;
+#endif
+	uint8_t rtna = ARRAY_SIZE(st7789v_frame_rates) - 1;
+	int ret;
+
+	/* Slowest setting still reaching the requested rate */
+	while (rtna > 0 && st7789v_frame_rates[rtna] < hz) {
+		rtna--;
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_PVGAMCTRL,
-			       (uint8_t *)config->pvgam_param,
-			       sizeof(config->pvgam_param));
+	ret = st7789v_lock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_NVGAMCTRL,
-			       (uint8_t *)config->nvgam_param,
-			       sizeof(config->nvgam_param));
-	if (ret < 0) {
-		return ret;
+	ret = st7789v_awake(dev);
+#ifdef CONFIG_PM_DEVICE
+	if (ret == -EBUSY) {
+		/* Sleep keeps FRCTRL2, the new rate goes out after wake-up */
+		data->rtna = rtna;
+		data->defer_rtna = true;
+		ret = 0;
+	} else
+#endif
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, ST7789V_CMD_FRCTRL2, &rtna, 1U);
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_RAMCTRL,
-			       (uint8_t *)config->ram_param,
-			       sizeof(config->ram_param));
+	st7789v_unlock(dev);
 	if (ret < 0) {
 		return ret;
 	}
 
-	ret = st7789v_transmit(dev, ST7789V_CMD_RGBCTRL,
-			       (uint8_t *)config->rgb_param,
-			       sizeof(config->rgb_param));
+	LOG_DBG("Frame rate %u Hz (RTNA 0x%02x)", st7789v_frame_rates[rtna], rtna);
+
+	return st7789v_frame_rates[rtna];
+}
+
+int st7789v_set_idle_mode(const struct device *dev, bool enable)
+{
+	return st7789v_command(dev, enable ? ST7789V_CMD_IDMON : ST7789V_CMD_IDMOFF, NULL, 0);
+}
+
+/* Play back the init stream within the caller's bus sequence: command, length, parameters */
+static int st7789v_lcd_init(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	const uint8_t *cmd = config->init_cmds;
+	const uint8_t *end = config->init_cmds + config->init_cmds_len;
+	int ret = 0;
+
+	while (cmd < end) {
+		uint8_t len;
+
+		if (end - cmd < 2 || end - cmd < 2 + cmd[1]) {
+			LOG_ERR("Truncated init stream at offset %d", (int)(cmd - config->init_cmds));
+			ret = -EINVAL;
+			break;
+		}
+
+		len = cmd[1];
+		ret = st7789v_seq_transmit(dev, cmd[0], len ? (uint8_t *)&cmd[2] : NULL, len);
+		if (ret < 0) {
+			break;
+		}
+
+		cmd += 2 + len;
+	}
+
 	return ret;
 }
 
+/*
+ * Run one step of the panel bring-up. delay is set to the time the panel
+ * needs before the next step.
+ */
+static int st7789v_init_step(const struct device *dev, k_timeout_t *delay)
+{
+	const struct st7789v_config *config __maybe_unused = dev->config;
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	switch (data->init_state) {
+	case ST7789V_INIT_RESET:
+		ret = st7789v_reset_display(dev, delay);
+		if (ret < 0) {
+			LOG_ERR("Failed to reset display (%d)", ret);
+			return ret;
+		}
+		data->init_state = ST7789V_INIT_CONFIGURE;
+		break;
+
+	case ST7789V_INIT_CONFIGURE:
+		/* Blank, configure, orient and wake the panel in one bus sequence */
+		ret = st7789v_seq_transmit(dev, ST7789V_CMD_DISP_OFF, NULL, 0);
+		if (ret == 0) {
+			ret = st7789v_lcd_init(dev);
+		}
+		if (ret == 0) {
+			ret = st7789v_seq_transmit(dev, ST7789V_CMD_MADCTL, &data->madctl, 1U);
+		}
+#ifdef CONFIG_ST7789V_RGB444
+		if (ret == 0) {
+			uint8_t colmod = (config->colmod & 0xf0) | ST7789V_COLMOD_FMT_12bit;
+
+			/* Start out in the 12 bit mode, overriding COLMOD of the init stream */
+			ret = st7789v_seq_transmit(dev, ST7789V_CMD_COLMOD, &colmod, 1U);
+			data->rgb444 = true;
+		}
+#endif
+#ifdef CONFIG_ST7789V_TE_SYNC
+		if (ret == 0 && config->te_gpio.port != NULL) {
+			/* TE output during vertical blanking only */
+			uint8_t te_mode = 0x00;
+
+			ret = st7789v_seq_transmit(dev, ST7789V_CMD_TEON, &te_mode, 1U);
+		}
+#endif
+		if (ret == 0) {
+			ret = st7789v_seq_transmit(dev, ST7789V_CMD_SLEEP_OUT, NULL, 0);
+		}
+		st7789v_seq_end(dev);
+		if (ret < 0) {
+			LOG_ERR("Failed to init display (%d)", ret);
+			return ret;
+		}
+		*delay = K_MSEC(120);
+		data->init_state = ST7789V_INIT_SLEEP_OUT;
+		break;
+
+	case ST7789V_INIT_SLEEP_OUT:
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+		if (data->init_unblank) {
+			ret = st7789v_transmit(dev, ST7789V_CMD_DISP_ON, NULL, 0);
+			if (ret < 0) {
+				LOG_ERR("Failed to switch display on (%d)", ret);
+				return ret;
+			}
+		}
+#endif
+		*delay = K_NO_WAIT;
+		data->init_state = ST7789V_INIT_DONE;
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+static void st7789v_init_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct st7789v_data *data = CONTAINER_OF(dwork, struct st7789v_data, init_work);
+	k_timeout_t delay = K_NO_WAIT;
+	int ret;
+
+	ret = st7789v_init_step(data->dev, &delay);
+	if (ret < 0) {
+		data->init_ret = ret;
+		data->init_state = ST7789V_INIT_DONE;
+	}
+
+	if (data->init_state == ST7789V_INIT_DONE) {
+		LOG_DBG("Display ready (%d)", data->init_ret);
+		k_sem_give(&data->ready);
+		return;
+	}
+
+	/* Each delay of the bring-up is a reschedule, the work queue never sleeps */
+	k_work_reschedule(&data->init_work, delay);
+}
+#endif /* CONFIG_ST7789V_DEFERRED_INIT */
+
 static int st7789v_init(const struct device *dev)
 {
 	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint8_t madctl;
 	int ret;
 
 	if (!device_is_ready(config->mipi_dbi)) {
@@ -471,53 +2042,88 @@ static int st7789v_init(const struct device *dev)
 		return -ENODEV;
 	}
 
-	k_sleep(K_TIMEOUT_ABS_MS(config->ready_time_ms));
+	data->dev = dev;
+	k_mutex_init(&data->lock);
 
-	ret = st7789v_reset_display(dev);
-	if (ret < 0) {
-		LOG_ERR("Failed to reset display (%d)", ret);
-		return ret;
-	}
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+	data->input_format = ST7789V_INPUT_FORMAT;
+	st7789v_default_palette(data);
+#endif
 
-	ret = st7789v_blanking_on(dev);
+#ifdef CONFIG_ST7789V_ASYNC_WRITE
+	st7789v_async_init(dev);
+#endif
+
+#ifdef CONFIG_ST7789V_TE_SYNC
+	ret = st7789v_te_init(dev);
 	if (ret < 0) {
-		LOG_ERR("Failed to turn blanking on (%d)", ret);
 		return ret;
 	}
+#endif
 
-	ret = st7789v_lcd_init(dev);
+	/* The final orientation goes out with the init sequence, before the first frame */
+	ret = st7789v_orientation_madctl(dev, config->orientation, &madctl);
 	if (ret < 0) {
-		LOG_ERR("Failed to init display (%d)", ret);
 		return ret;
 	}
 
-	ret = st7789v_exit_sleep(dev);
-	if (ret < 0) {
-		LOG_ERR("Failed to exit the sleep mode (%d)", ret);
-		return ret;
+	data->init_state = ST7789V_INIT_RESET;
+	data->init_ret = 0;
+
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	/* Bring the panel up from the system work queue instead of stalling boot */
+	k_sem_init(&data->ready, 0, 1);
+	k_work_init_delayable(&data->init_work, st7789v_init_work_handler);
+	k_work_schedule(&data->init_work, K_TIMEOUT_ABS_MS(config->ready_time_ms));
+#else
+	k_sleep(K_TIMEOUT_ABS_MS(config->ready_time_ms));
+
+	while (data->init_state != ST7789V_INIT_DONE) {
+		k_timeout_t delay = K_NO_WAIT;
+
+		ret = st7789v_init_step(dev, &delay);
+		if (ret < 0) {
+			data->init_ret = ret;
+			return ret;
+		}
+
+		k_sleep(delay);
 	}
+#endif
 
-	return ret;
+	return 0;
 }
 
 #ifdef CONFIG_PM_DEVICE
 static int st7789v_pm_action(const struct device *dev,
 			     enum pm_device_action action)
 {
+	struct st7789v_data *data = dev->data;
 	int ret;
 
+	ret = st7789v_lock(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
 	switch (action) {
 	case PM_DEVICE_ACTION_RESUME:
-		ret = st7789v_exit_sleep(dev);
+		ret = data->asleep ? st7789v_exit_sleep(dev) : 0;
 		break;
 	case PM_DEVICE_ACTION_SUSPEND:
-		ret = st7789v_transmit(dev, ST7789V_CMD_SLEEP_IN, NULL, 0);
+		/* Also waits out a recent SLPOUT, SLPIN must not follow it within 120 ms */
+		ret = st7789v_awake(dev);
+		if (ret == 0) {
+			ret = st7789v_enter_sleep(dev);
+		}
 		break;
 	default:
 		ret = -ENOTSUP;
 		break;
 	}
 
+	st7789v_unlock(dev);
+
 	return ret;
 }
 #endif /* CONFIG_PM_DEVICE */
@@ -531,36 +2137,96 @@ static DEVICE_API(display, st7789v_api) = {
 	.set_orientation = st7789v_set_orientation,
 };
 
+#define ST7789V_INIT_BYTES(inst, cmd, prop)						\
+	cmd, DT_INST_PROP_LEN(inst, prop),						\
+	DT_INST_FOREACH_PROP_ELEM_SEP(inst, prop, DT_PROP_BY_IDX, (,)),
+
+#define ST7789V_INIT_BYTE(cmd, value) cmd, 1, value,
+
+/*
+ * Init stream built from the individual panel properties. MADCTL is sent
+ * separately with the orientation bits already applied.
+ */
+#define ST7789V_INIT_STREAM(inst)							\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_CMD2EN, cmd2en_param)			\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_PORCTRL, porch_param)			\
+	/* Digital Gamma Enable, default disabled */					\
+	ST7789V_INIT_BYTE(ST7789V_CMD_DGMEN, 0x00)					\
+	/* Frame Rate Control in Normal Mode, default value */				\
+	ST7789V_INIT_BYTE(ST7789V_CMD_FRCTRL2, 0x0f)					\
+	ST7789V_INIT_BYTE(ST7789V_CMD_GCTRL, DT_INST_PROP(inst, gctrl))		\
+	ST7789V_INIT_BYTE(ST7789V_CMD_VCOMS, DT_INST_PROP(inst, vcom))			\
+	IF_ENABLED(UTIL_AND(DT_INST_NODE_HAS_PROP(inst, vrhs),				\
+			    DT_INST_NODE_HAS_PROP(inst, vdvs)), (			\
+		ST7789V_INIT_BYTE(ST7789V_CMD_VDVVRHEN, 0x01)				\
+		ST7789V_INIT_BYTE(ST7789V_CMD_VRH, DT_INST_PROP(inst, vrhs))		\
+		ST7789V_INIT_BYTE(ST7789V_CMD_VDS, DT_INST_PROP(inst, vdvs))))	\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_PWCTRL1, pwctrl1_param)			\
+	/* Interface Pixel Format */							\
+	ST7789V_INIT_BYTE(ST7789V_CMD_COLMOD, DT_INST_PROP(inst, colmod))		\
+	ST7789V_INIT_BYTE(ST7789V_CMD_LCMCTRL, DT_INST_PROP(inst, lcm))		\
+	ST7789V_INIT_BYTE(ST7789V_CMD_GAMSET, DT_INST_PROP(inst, gamma))		\
+	COND_CODE_1(DT_INST_PROP(inst, inversion_off),					\
+		    (ST7789V_CMD_INV_OFF), (ST7789V_CMD_INV_ON)), 0,			\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_PVGAMCTRL, pvgam_param)			\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_NVGAMCTRL, nvgam_param)			\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_RAMCTRL, ram_param)			\
+	ST7789V_INIT_BYTES(inst, ST7789V_CMD_RGBCTRL, rgb_param)
+
+/* An init-cmds property replaces the generated stream */
+#define ST7789V_INIT_CMDS_DEFINE(inst)							\
+	static const uint8_t st7789v_init_cmds_ ## inst[] = {				\
+		COND_CODE_1(DT_INST_NODE_HAS_PROP(inst, init_cmds),			\
+			    (DT_INST_FOREACH_PROP_ELEM_SEP(inst, init_cmds,		\
+							   DT_PROP_BY_IDX, (,))),	\
+			    (ST7789V_INIT_STREAM(inst)))				\
+	};
+
+#if defined(CONFIG_ST7789V_INIT_ORIENTATION_NORMAL)
+#define ST7789V_INIT_ORIENTATION(inst) DISPLAY_ORIENTATION_NORMAL
+#elif defined(CONFIG_ST7789V_INIT_ORIENTATION_90)
+#define ST7789V_INIT_ORIENTATION(inst) DISPLAY_ORIENTATION_ROTATED_90
+#elif defined(CONFIG_ST7789V_INIT_ORIENTATION_180)
+#define ST7789V_INIT_ORIENTATION(inst) DISPLAY_ORIENTATION_ROTATED_180
+#elif defined(CONFIG_ST7789V_INIT_ORIENTATION_270)
+#define ST7789V_INIT_ORIENTATION(inst) DISPLAY_ORIENTATION_ROTATED_270
+#else
+/* Orientation enum values follow the rotation in steps of 90 degrees */
+#define ST7789V_INIT_ORIENTATION(inst)							\
+	((enum display_orientation)(DT_INST_PROP_OR(inst, rotation, 0) / 90))
+#endif
+
 #define ST7789V_WORD_SIZE(inst)								\
 	((DT_INST_STRING_UPPER_TOKEN(inst, mipi_mode) == MIPI_DBI_MODE_SPI_4WIRE) ?     \
 	SPI_WORD_SET(8) : SPI_WORD_SET(9))
 #define ST7789V_INIT(inst)								\
+	ST7789V_BOUNCE_BUF_DEFINE(inst)							\
+	ST7789V_ROW_HASH_DEFINE(inst)							\
+	ST7789V_INIT_CMDS_DEFINE(inst)							\
+											\
 	static const struct st7789v_config st7789v_config_ ## inst = {			\
 		.mipi_dbi = DEVICE_DT_GET(DT_INST_PARENT(inst)),                        \
 		.dbi_config = MIPI_DBI_CONFIG_DT_INST(inst,                             \
 						      ST7789V_WORD_SIZE(inst) |         \
 						      SPI_OP_MODE_MASTER, 0),           \
-		.vcom = DT_INST_PROP(inst, vcom),					\
-		.gctrl = DT_INST_PROP(inst, gctrl),					\
-		.vdv_vrh_enable = (DT_INST_NODE_HAS_PROP(inst, vrhs)			\
-					&& DT_INST_NODE_HAS_PROP(inst, vdvs)),		\
-		.vrh_value = DT_INST_PROP_OR(inst, vrhs, 0),				\
-		.vdv_value = DT_INST_PROP_OR(inst, vdvs, 0),				\
+		.dbi_config_seq = MIPI_DBI_CONFIG_DT_INST(inst,                         \
+							  ST7789V_WORD_SIZE(inst) |     \
+							  SPI_OP_MODE_MASTER |          \
+							  SPI_LOCK_ON, 0),              \
 		.mdac = DT_INST_PROP(inst, mdac),					\
-		.gamma = DT_INST_PROP(inst, gamma),					\
 		.colmod = DT_INST_PROP(inst, colmod),					\
-		.lcm = DT_INST_PROP(inst, lcm),						\
-		.inversion_on = !DT_INST_PROP(inst, inversion_off),			\
-		.porch_param = DT_INST_PROP(inst, porch_param),				\
-		.cmd2en_param = DT_INST_PROP(inst, cmd2en_param),			\
-		.pwctrl1_param = DT_INST_PROP(inst, pwctrl1_param),			\
-		.pvgam_param = DT_INST_PROP(inst, pvgam_param),				\
-		.nvgam_param = DT_INST_PROP(inst, nvgam_param),				\
-		.ram_param = DT_INST_PROP(inst, ram_param),				\
-		.rgb_param = DT_INST_PROP(inst, rgb_param),				\
+		IF_ENABLED(CONFIG_ST7789V_TE_SYNC,					\
+			(.te_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, te_gpios, {0}),))	\
+		.orientation = ST7789V_INIT_ORIENTATION(inst),				\
+		.init_cmds = st7789v_init_cmds_ ## inst,				\
+		.init_cmds_len = sizeof(st7789v_init_cmds_ ## inst),			\
 		.width = DT_INST_PROP(inst, width),					\
 		.height = DT_INST_PROP(inst, height),					\
 		.ready_time_ms = DT_INST_PROP(inst, ready_time_ms),			\
+		.bounce_buf = ST7789V_BOUNCE_BUF_GET(inst),				\
+		IF_ENABLED(CONFIG_ST7789V_ROW_HASH,					\
+			(.row_hash = st7789v_row_hash_ ## inst,				\
+			 .row_hash_rows = ST7789V_ROW_HASH_ROWS(inst),))		\
 	};										\
 											\
 	static struct st7789v_data st7789v_data_ ## inst = {				\
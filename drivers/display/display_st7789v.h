@@ -13,6 +13,8 @@
 
 #define ST7789V_CMD_SLEEP_IN			0x10
 #define ST7789V_CMD_SLEEP_OUT			0x11
+#define ST7789V_CMD_PTLON			0x12
+#define ST7789V_CMD_NORON			0x13
 #define ST7789V_CMD_INV_OFF			0x20
 #define ST7789V_CMD_INV_ON			0x21
 #define ST7789V_CMD_GAMSET			0x26
@@ -22,6 +24,10 @@
 #define ST7789V_CMD_CASET			0x2a
 #define ST7789V_CMD_RASET			0x2b
 #define ST7789V_CMD_RAMWR			0x2c
+#define ST7789V_CMD_PTLAR			0x30
+#define ST7789V_CMD_VSCRDEF			0x33
+#define ST7789V_CMD_TEOFF			0x34
+#define ST7789V_CMD_TEON			0x35
 
 #define ST7789V_CMD_MADCTL			0x36
 #define ST7789V_MADCTL_MY_TOP_TO_BOTTOM		0x00
@@ -36,6 +42,10 @@
 #define ST7789V_MADCTL_MH_LEFT_TO_RIGHT		0x00
 #define ST7789V_MADCTL_MH_RIGHT_TO_LEFT		0x04
 
+#define ST7789V_CMD_VSCSAD			0x37
+#define ST7789V_CMD_IDMOFF			0x38
+#define ST7789V_CMD_IDMON			0x39
+
 #define ST7789V_CMD_COLMOD			0x3a
 #define ST7789V_COLMOD_RGB_65K			(0x5 << 4)
 #define ST7789V_COLMOD_RGB_262K			(0x6 << 4)
@@ -70,4 +80,7 @@
 
 #define ST7789V_CMD_NONE			0xff
 
+/* Gate lines addressed by the frame memory */
+#define ST7789V_GRAM_ROWS			320
+
 #endif
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zmk_mipi_dbi_st7789v_emul
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/mipi_dbi.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include <drivers/mipi_dbi/st7789v_emul.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mipi_dbi_st7789v_emul, CONFIG_MIPI_DBI_LOG_LEVEL);
+
+/* Commands decoded by the emulator, kept apart from the driver on purpose */
+#define EMUL_CMD_SW_RESET	0x01
+#define EMUL_CMD_SLEEP_IN	0x10
+#define EMUL_CMD_SLEEP_OUT	0x11
+#define EMUL_CMD_PTLON		0x12
+#define EMUL_CMD_NORON		0x13
+#define EMUL_CMD_DISP_OFF	0x28
+#define EMUL_CMD_DISP_ON	0x29
+#define EMUL_CMD_CASET		0x2a
+#define EMUL_CMD_RASET		0x2b
+#define EMUL_CMD_RAMWR		0x2c
+#define EMUL_CMD_PTLAR		0x30
+#define EMUL_CMD_VSCRDEF	0x33
+#define EMUL_CMD_TEOFF		0x34
+#define EMUL_CMD_TEON		0x35
+#define EMUL_CMD_MADCTL		0x36
+#define EMUL_CMD_VSCSAD		0x37
+#define EMUL_CMD_IDMOFF		0x38
+#define EMUL_CMD_IDMON		0x39
+#define EMUL_CMD_COLMOD		0x3a
+#define EMUL_CMD_FRCTRL2	0xc6
+
+#define EMUL_MADCTL_MY		BIT(7)
+#define EMUL_MADCTL_MX		BIT(6)
+#define EMUL_MADCTL_MV		BIT(5)
+
+#define EMUL_COLMOD_12BIT	0x03
+#define EMUL_COLMOD_MASK	0x07
+
+struct st7789v_emul_config {
+	uint16_t *gram;
+};
+
+struct st7789v_emul_data {
+	struct st7789v_emul_stats stats;
+	struct st7789v_emul_state state;
+	/* Column and row address window */
+	uint16_t xs;
+	uint16_t xe;
+	uint16_t ys;
+	uint16_t ye;
+	/* Next address written by RAMWR */
+	uint16_t col;
+	uint16_t row;
+	bool ramwr;
+	/* Bytes of a pixel (pair) split across transfers */
+	uint8_t pending[3];
+	uint8_t pending_len;
+	/* Error returned by the next pixel transfer, which is then dropped */
+	int fail_ret;
+};
+
+static void st7789v_emul_power_on(struct st7789v_emul_data *data)
+{
+	/* Register defaults after reset */
+	data->state = (struct st7789v_emul_state){
+		.sleeping = true,
+		.colmod = 0x66,
+		.frctrl2 = 0x0f,
+		.partial_end = ST7789V_EMUL_GRAM_HEIGHT - 1,
+		.scroll_area = ST7789V_EMUL_GRAM_HEIGHT,
+	};
+	data->xs = 0U;
+	data->xe = ST7789V_EMUL_GRAM_WIDTH - 1;
+	data->ys = 0U;
+	data->ye = ST7789V_EMUL_GRAM_HEIGHT - 1;
+	data->ramwr = false;
+	data->pending_len = 0U;
+}
+
+/* Store a pixel at the current address, mapped through MADCTL, and advance */
+static void st7789v_emul_put_pixel(const struct device *dev, uint16_t rgb565)
+{
+	const struct st7789v_emul_config *config = dev->config;
+	struct st7789v_emul_data *data = dev->data;
+	const uint8_t madctl = data->state.madctl;
+	const bool mv = (madctl & EMUL_MADCTL_MV) != 0U;
+	uint16_t col = data->col;
+	uint16_t row = data->row;
+	uint16_t x;
+	uint16_t y;
+
+	if (madctl & EMUL_MADCTL_MX) {
+		col = (mv ? ST7789V_EMUL_GRAM_HEIGHT : ST7789V_EMUL_GRAM_WIDTH) - 1 - col;
+	}
+	if (madctl & EMUL_MADCTL_MY) {
+		row = (mv ? ST7789V_EMUL_GRAM_WIDTH : ST7789V_EMUL_GRAM_HEIGHT) - 1 - row;
+	}
+
+	x = mv ? row : col;
+	y = mv ? col : row;
+
+	if (x < ST7789V_EMUL_GRAM_WIDTH && y < ST7789V_EMUL_GRAM_HEIGHT) {
+		config->gram[y * ST7789V_EMUL_GRAM_WIDTH + x] = rgb565;
+	}
+	data->stats.pixels++;
+
+	if (data->col < data->xe) {
+		data->col++;
+		return;
+	}
+
+	data->col = data->xs;
+	data->row = data->row < data->ye ? data->row + 1 : data->ys;
+}
+
+static uint16_t st7789v_emul_rgb444_to_565(uint16_t rgb444)
+{
+	uint16_t r = (rgb444 >> 8) & 0x0f;
+	uint16_t g = (rgb444 >> 4) & 0x0f;
+	uint16_t b = rgb444 & 0x0f;
+
+	/* Widen each channel by repeating its top bits */
+	return (r << 12) | ((r >> 3) << 11) | (g << 7) | ((g >> 2) << 5) |
+	       (b << 1) | (b >> 3);
+}
+
+/* Decode pending pixel bytes, a trailing odd 12 bit pixel only when flushing */
+static void st7789v_emul_decode(const struct device *dev, bool flush)
+{
+	struct st7789v_emul_data *data = dev->data;
+	const uint8_t *p = data->pending;
+
+	if ((data->state.colmod & EMUL_COLMOD_MASK) == EMUL_COLMOD_12BIT) {
+		if (data->pending_len == 3U) {
+			st7789v_emul_put_pixel(dev, st7789v_emul_rgb444_to_565((p[0] << 4) |
+									       (p[1] >> 4)));
+			st7789v_emul_put_pixel(dev, st7789v_emul_rgb444_to_565(((p[1] & 0x0f) << 8) |
+									       p[2]));
+			data->pending_len = 0U;
+		} else if (flush && data->pending_len == 2U) {
+			st7789v_emul_put_pixel(dev, st7789v_emul_rgb444_to_565((p[0] << 4) |
+									       (p[1] >> 4)));
+			data->pending_len = 0U;
+		}
+	} else if (data->pending_len == 2U) {
+		st7789v_emul_put_pixel(dev, sys_get_be16(p));
+		data->pending_len = 0U;
+	}
+
+	if (flush) {
+		data->pending_len = 0U;
+	}
+}
+
+static void st7789v_emul_feed(const struct device *dev, const uint8_t *buf, size_t len)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	for (size_t i = 0U; i < len; i++) {
+		data->pending[data->pending_len++] = buf[i];
+		st7789v_emul_decode(dev, false);
+	}
+}
+
+static int st7789v_emul_command_write(const struct device *dev,
+				      const struct mipi_dbi_config *dbi_config,
+				      uint8_t cmd, const uint8_t *buf, size_t len)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	data->stats.commands++;
+	data->stats.bytes += 1U + len;
+
+	/* Any command ends a running memory write */
+	if (data->ramwr) {
+		st7789v_emul_decode(dev, true);
+		data->ramwr = false;
+	}
+
+	switch (cmd) {
+	case EMUL_CMD_SW_RESET:
+		st7789v_emul_power_on(data);
+		break;
+	case EMUL_CMD_SLEEP_IN:
+		data->state.sleeping = true;
+		break;
+	case EMUL_CMD_SLEEP_OUT:
+		data->state.sleeping = false;
+		break;
+	case EMUL_CMD_PTLON:
+		data->state.partial_mode = true;
+		break;
+	case EMUL_CMD_NORON:
+		data->state.partial_mode = false;
+		break;
+	case EMUL_CMD_DISP_OFF:
+		data->state.display_on = false;
+		break;
+	case EMUL_CMD_DISP_ON:
+		data->state.display_on = true;
+		break;
+	case EMUL_CMD_CASET:
+		if (len >= 4U) {
+			data->xs = sys_get_be16(&buf[0]);
+			data->xe = sys_get_be16(&buf[2]);
+		}
+		break;
+	case EMUL_CMD_RASET:
+		if (len >= 4U) {
+			data->ys = sys_get_be16(&buf[0]);
+			data->ye = sys_get_be16(&buf[2]);
+		}
+		break;
+	case EMUL_CMD_RAMWR:
+		data->col = data->xs;
+		data->row = data->ys;
+		data->pending_len = 0U;
+		data->ramwr = true;
+		st7789v_emul_feed(dev, buf, len);
+		break;
+	case EMUL_CMD_PTLAR:
+		if (len >= 4U) {
+			data->state.partial_start = sys_get_be16(&buf[0]);
+			data->state.partial_end = sys_get_be16(&buf[2]);
+		}
+		break;
+	case EMUL_CMD_VSCRDEF:
+		if (len >= 6U) {
+			data->state.scroll_top = sys_get_be16(&buf[0]);
+			data->state.scroll_area = sys_get_be16(&buf[2]);
+			data->state.scroll_bottom = sys_get_be16(&buf[4]);
+		}
+		break;
+	case EMUL_CMD_TEOFF:
+		data->state.te_on = false;
+		break;
+	case EMUL_CMD_TEON:
+		data->state.te_on = true;
+		data->state.te_mode = len >= 1U ? buf[0] : 0U;
+		break;
+	case EMUL_CMD_MADCTL:
+		if (len >= 1U) {
+			data->state.madctl = buf[0];
+		}
+		break;
+	case EMUL_CMD_VSCSAD:
+		if (len >= 2U) {
+			data->state.scroll_start = sys_get_be16(buf);
+		}
+		break;
+	case EMUL_CMD_IDMOFF:
+		data->state.idle_mode = false;
+		break;
+	case EMUL_CMD_IDMON:
+		data->state.idle_mode = true;
+		break;
+	case EMUL_CMD_COLMOD:
+		if (len >= 1U) {
+			data->state.colmod = buf[0];
+		}
+		break;
+	case EMUL_CMD_FRCTRL2:
+		if (len >= 1U) {
+			data->state.frctrl2 = buf[0];
+		}
+		break;
+	default:
+		/* Panel setup commands do not change the emulated state */
+		break;
+	}
+
+	return 0;
+}
+
+static int st7789v_emul_write_display(const struct device *dev,
+				      const struct mipi_dbi_config *dbi_config,
+				      const uint8_t *framebuf,
+				      struct display_buffer_descriptor *desc,
+				      enum display_pixel_format pixfmt)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	data->stats.transfers++;
+	data->stats.bytes += desc->buf_size;
+	data->stats.max_transfer = MAX(data->stats.max_transfer, desc->buf_size);
+
+	if (data->fail_ret < 0) {
+		int ret = data->fail_ret;
+
+		data->fail_ret = 0;
+		return ret;
+	}
+
+	if (!data->ramwr) {
+		LOG_WRN("Pixel data without RAMWR, %u bytes dropped", desc->buf_size);
+		return 0;
+	}
+
+	st7789v_emul_feed(dev, framebuf, desc->buf_size);
+
+	return 0;
+}
+
+static int st7789v_emul_reset(const struct device *dev, k_timeout_t delay)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	st7789v_emul_power_on(data);
+
+	return 0;
+}
+
+static int st7789v_emul_release(const struct device *dev,
+				const struct mipi_dbi_config *dbi_config)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	data->stats.releases++;
+
+	return 0;
+}
+
+void st7789v_emul_get_stats(const struct device *dev, struct st7789v_emul_stats *stats)
+{
+	const struct st7789v_emul_data *data = dev->data;
+
+	*stats = data->stats;
+}
+
+void st7789v_emul_reset_stats(const struct device *dev)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	memset(&data->stats, 0, sizeof(data->stats));
+}
+
+void st7789v_emul_get_state(const struct device *dev, struct st7789v_emul_state *state)
+{
+	const struct st7789v_emul_data *data = dev->data;
+
+	*state = data->state;
+}
+
+void st7789v_emul_fail_next(const struct device *dev, int err)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	data->fail_ret = err;
+}
+
+const uint16_t *st7789v_emul_gram(const struct device *dev)
+{
+	const struct st7789v_emul_config *config = dev->config;
+
+	return config->gram;
+}
+
+static int st7789v_emul_init(const struct device *dev)
+{
+	struct st7789v_emul_data *data = dev->data;
+
+	st7789v_emul_power_on(data);
+
+	return 0;
+}
+
+static DEVICE_API(mipi_dbi, st7789v_emul_api) = {
+	.command_write = st7789v_emul_command_write,
+	.write_display = st7789v_emul_write_display,
+	.reset = st7789v_emul_reset,
+	.release = st7789v_emul_release,
+};
+
+#define ST7789V_EMUL_INIT(inst)								\
+	static uint16_t st7789v_emul_gram_##inst[ST7789V_EMUL_GRAM_WIDTH *		\
+						 ST7789V_EMUL_GRAM_HEIGHT];		\
+											\
+	static const struct st7789v_emul_config st7789v_emul_config_##inst = {		\
+		.gram = st7789v_emul_gram_##inst,					\
+	};										\
+											\
+	static struct st7789v_emul_data st7789v_emul_data_##inst;			\
+											\
+	DEVICE_DT_INST_DEFINE(inst, st7789v_emul_init, NULL,				\
+			      &st7789v_emul_data_##inst, &st7789v_emul_config_##inst,	\
+			      POST_KERNEL, CONFIG_MIPI_DBI_INIT_PRIORITY,		\
+			      &st7789v_emul_api);
+
+DT_INST_FOREACH_STATUS_OKAY(ST7789V_EMUL_INIT)
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @brief Extensions of the ST7789V display driver beyond the Zephyr display API.
+ *
+ * Coordinates of the partial and scroll areas run along the axis the panel
+ * scans its rows on: y for the normal and 180 degree orientations, x for the
+ * 90 and 270 degree orientations. Such a band always spans the full other
+ * axis of the screen.
+ *
+ * With CONFIG_ST7789V_ASYNC_WRITE, display_write() returns once the transfer
+ * is queued. It returns 0 for a transfer that fails later on the bus; the
+ * error is returned by the next display_write() instead, and counted in
+ * st7789v_stats::errors. The caller has already been told the frame was
+ * flushed, and the failed area shows again only when it is redrawn.
+ */
+
+/**
+ * @brief Pixel format selecting the 12 bit RGB444 interface mode
+ *
+ * Pass to display_set_pixel_format() to send two pixels in three bytes, and
+ * RGB565 to return to the 16 bit mode. Buffers handed to display_write() stay
+ * RGB565 in both modes, so the current pixel format reported by
+ * display_get_capabilities() does not change. Needs CONFIG_ST7789V_RGB444.
+ */
+#define PIXEL_FORMAT_ST7789V_RGB_444 ((enum display_pixel_format)BIT(15))
+
+/**
+ * @brief Limit the panel scan to a band of the screen (PTLAR/PTLON)
+ *
+ * Everything outside the band is shown black. Frame memory outside the band
+ * is kept and shows again once the partial mode is left.
+ *
+ * @param dev ST7789V device
+ * @param start First line of the band in display coordinates
+ * @param len Number of lines in the band, 0 returns to normal mode (NORON)
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the band does not fit on the screen
+ * @retval -EBUSY if the panel is suspended
+ */
+int st7789v_set_partial_area(const struct device *dev, uint16_t start, uint16_t len);
+
+/**
+ * @brief Switch the 8 colour idle mode (IDMON/IDMOFF)
+ *
+ * In idle mode only the most significant bit of each colour channel is shown.
+ *
+ * @param dev ST7789V device
+ * @param enable true to enter idle mode, false to leave it
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if the panel is suspended
+ */
+int st7789v_set_idle_mode(const struct device *dev, bool enable);
+
+/**
+ * @brief Define the band moved by hardware scrolling (VSCRDEF)
+ *
+ * The lines outside the band stay fixed. The scroll offset starts at 0.
+ * Changing the orientation drops the band, define it again afterwards.
+ *
+ * @param dev ST7789V device
+ * @param start First line of the band in display coordinates
+ * @param len Number of lines in the band, 0 scrolls the whole frame memory
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the band does not fit on the screen
+ * @retval -EBUSY if the panel is suspended
+ */
+int st7789v_set_scroll_area(const struct device *dev, uint16_t start, uint16_t len);
+
+/**
+ * @brief Scroll the band defined with st7789v_set_scroll_area() (VSCSAD)
+ *
+ * Line n of the band shows the content written to line (n + offset) % len,
+ * wrapping around. Writes keep addressing the unscrolled lines.
+ *
+ * @param dev ST7789V device
+ * @param offset Scroll offset in lines
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if no scroll area is defined
+ * @retval -EBUSY if the panel is suspended
+ */
+int st7789v_set_scroll_offset(const struct device *dev, uint16_t offset);
+
+/**
+ * @brief Set the rate the panel refreshes itself from frame memory (FRCTRL2)
+ *
+ * Picks the slowest setting at or above the requested rate, between 39 Hz
+ * and 119 Hz. A lower rate saves power while the content is static. While
+ * the panel is suspended the rate is kept and applied after it resumes.
+ *
+ * @param dev ST7789V device
+ * @param hz Requested frame rate in Hz
+ *
+ * @return Applied frame rate in Hz, or a negative error code
+ */
+int st7789v_set_frame_rate(const struct device *dev, uint8_t hz);
+
+/**
+ * @brief Set the colours that indexed buffers expand to
+ *
+ * With CONFIG_ST7789V_INDEXED_INPUT, lit pixels of MONO01/MONO10 buffers
+ * use entry 1 and dark pixels entry 0. Pixels of L_8 buffers use the entry
+ * of their value. Changing the pixel format restores the default palette.
+ *
+ * @param dev ST7789V device
+ * @param colors RGB565 colours in CPU byte order
+ * @param count Number of entries to set, starting at 0, up to 256
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if count exceeds the palette
+ */
+int st7789v_set_palette(const struct device *dev, const uint16_t *colors, size_t count);
+
+/**
+ * @brief Fill a rectangle with a single colour
+ *
+ * Streams a short repeated pattern, no caller buffer is needed. Needs
+ * CONFIG_ST7789V_FILL.
+ *
+ * @param dev ST7789V device
+ * @param x Left edge in display coordinates
+ * @param y Top edge in display coordinates
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ * @param color RGB565 colour in CPU byte order
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if the panel is suspended
+ */
+int st7789v_fill(const struct device *dev, uint16_t x, uint16_t y,
+		 uint16_t width, uint16_t height, uint16_t color);
+
+/** Number of buckets in the latency histogram of struct st7789v_stats */
+#define ST7789V_STATS_LATENCY_BUCKETS 8
+
+/** Bus traffic and time spent by the driver, see st7789v_get_stats() */
+struct st7789v_stats {
+	/** Writes through display_write(), including failed ones */
+	uint32_t flushes;
+	/** Fills through st7789v_fill() */
+	uint32_t fills;
+	/** Writes dropped while the panel was asleep */
+	uint32_t dropped;
+	/** Failed writes and fills */
+	uint32_t errors;
+	/** Pixels sent to the panel */
+	uint64_t pixels;
+	/** Pixel data bytes sent to the panel, after any conversion */
+	uint64_t bytes;
+	/** Pixel data transfers handed to the MIPI-DBI controller */
+	uint32_t transfers;
+	/** Column address commands sent, unchanged windows are skipped */
+	uint32_t caset;
+	/** Row address commands sent, unchanged windows are skipped */
+	uint32_t raset;
+	/** Rows not sent because the panel already showed them, with CONFIG_ST7789V_ROW_HASH */
+	uint32_t rows_skipped;
+	/** Total time spent in writes, in microseconds */
+	uint32_t busy_us;
+	/** Longest write, in microseconds */
+	uint32_t max_us;
+	/**
+	 * Writes by duration: bucket 0 counts writes under 1 ms, bucket n
+	 * writes of 2^(n-1) ms up to 2^n ms, the last bucket everything longer.
+	 */
+	uint32_t latency[ST7789V_STATS_LATENCY_BUCKETS];
+};
+
+/**
+ * @brief Read the transfer statistics of the driver
+ *
+ * Counters run from boot or the last st7789v_reset_stats(). With
+ * CONFIG_ST7789V_ASYNC_WRITE the durations cover the transfer on the bus,
+ * not the time display_write() blocks. Waits for a transfer in flight, so
+ * the snapshot is consistent. Needs CONFIG_ST7789V_STATS.
+ *
+ * @param dev ST7789V device
+ * @param stats Filled with the current counters
+ *
+ * @retval 0 on success
+ */
+int st7789v_get_stats(const struct device *dev, struct st7789v_stats *stats);
+
+/**
+ * @brief Clear the transfer statistics of the driver
+ *
+ * Waits for a transfer in flight, so its counts are not lost or half cleared.
+ *
+ * @param dev ST7789V device
+ *
+ * @retval 0 on success
+ */
+int st7789v_reset_stats(const struct device *dev);
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/**
+ * @brief Emulated MIPI-DBI controller with an ST7789V panel
+ *
+ * The frame memory is kept in the physical layout of the panel: 240
+ * columns by 320 rows of RGB565 pixels in CPU byte order, independent of
+ * MADCTL.
+ */
+
+#define ST7789V_EMUL_GRAM_WIDTH  240
+#define ST7789V_EMUL_GRAM_HEIGHT 320
+
+/** Bus traffic seen by the emulator */
+struct st7789v_emul_stats {
+	/** Commands received */
+	uint32_t commands;
+	/** Pixel transfers received */
+	uint32_t transfers;
+	/** Longest pixel transfer in bytes */
+	uint32_t max_transfer;
+	/** Bytes received, command bytes included */
+	uint64_t bytes;
+	/** Pixels written to frame memory */
+	uint64_t pixels;
+	/** Bus sequences closed by a release */
+	uint32_t releases;
+};
+
+/** Panel state decoded from the command stream */
+struct st7789v_emul_state {
+	bool sleeping;
+	bool display_on;
+	bool idle_mode;
+	bool partial_mode;
+	/** Tearing effect output enabled (TEON) */
+	bool te_on;
+	/** TEON parameter, 0 for V-blank only */
+	uint8_t te_mode;
+	uint8_t madctl;
+	uint8_t colmod;
+	/** RTNA setting of FRCTRL2 */
+	uint8_t frctrl2;
+	/** First and last frame memory row of the partial area (PTLAR) */
+	uint16_t partial_start;
+	uint16_t partial_end;
+	/** Top fixed, scroll and bottom fixed areas in rows (VSCRDEF) */
+	uint16_t scroll_top;
+	uint16_t scroll_area;
+	uint16_t scroll_bottom;
+	uint16_t scroll_start;
+};
+
+/**
+ * @brief Get the traffic counters
+ *
+ * @param dev Emulated controller
+ * @param stats Counters since boot or the last reset
+ */
+void st7789v_emul_get_stats(const struct device *dev, struct st7789v_emul_stats *stats);
+
+/**
+ * @brief Reset the traffic counters
+ *
+ * @param dev Emulated controller
+ */
+void st7789v_emul_reset_stats(const struct device *dev);
+
+/**
+ * @brief Get the decoded panel state
+ *
+ * @param dev Emulated controller
+ * @param state Current panel state
+ */
+void st7789v_emul_get_state(const struct device *dev, struct st7789v_emul_state *state);
+
+/**
+ * @brief Make the next pixel transfer fail
+ *
+ * The transfer is counted, its pixels are dropped and err is returned to
+ * the driver. Later transfers succeed again.
+ *
+ * @param dev Emulated controller
+ * @param err Negative errno value to return
+ */
+void st7789v_emul_fail_next(const struct device *dev, int err);
+
+/**
+ * @brief Get the frame memory
+ *
+ * @param dev Emulated controller
+ *
+ * @return ST7789V_EMUL_GRAM_WIDTH x ST7789V_EMUL_GRAM_HEIGHT RGB565 pixels, row by row
+ */
+const uint16_t *st7789v_emul_gram(const struct device *dev);
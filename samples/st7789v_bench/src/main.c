@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Drives display_write() on the ST7789V with a matrix of region sizes,
+ * pitches, source alignments and contents and prints the achieved pixel
+ * rate and the time per call. On native_sim the writes go to the emulated
+ * controller, whose counters show the bus traffic per write. Simulated time
+ * does not advance while the CPU works, so only the traffic columns are
+ * meaningful there.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/sys/printk.h>
+
+#include <drivers/display/st7789v.h>
+
+#ifdef CONFIG_MIPI_DBI_ST7789V_EMUL
+#include <drivers/mipi_dbi/st7789v_emul.h>
+#endif
+
+#define BENCH_PITCH_PAD 8U
+#define BENCH_MAX_WIDTH 240U
+/* Room for a full screen row in either orientation, the pitch of direct rendering */
+#define BENCH_MAX_PITCH 320U
+#define BENCH_BUF_PIXELS (BENCH_MAX_PITCH * CONFIG_ST7789V_BENCH_MAX_ROWS)
+
+struct bench_case {
+	uint16_t width;
+	uint16_t height;
+	/* Extra pixels at the end of each source row */
+	uint16_t pad;
+	/* Byte offset of the source from a 4 byte boundary */
+	uint8_t offset;
+	/* All pixels one colour, which takes the fill path of the driver */
+	bool solid;
+};
+
+/* Two spare pixels hold the misaligned start */
+static uint16_t bench_buf[BENCH_BUF_PIXELS + 2] __aligned(4);
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+#ifdef CONFIG_MIPI_DBI_ST7789V_EMUL
+static const struct device *dbi = DEVICE_DT_GET(DT_PARENT(DT_CHOSEN(zephyr_display)));
+#endif
+
+static void bench_fill(uint16_t *buf, size_t pixels, bool solid)
+{
+	for (size_t i = 0U; i < pixels; i++) {
+		buf[i] = solid ? 0x07e0 : (uint16_t)(i * 0x0821);
+	}
+}
+
+static void bench_run(const struct bench_case *bc, uint16_t screen_h)
+{
+	const uint16_t pitch = bc->width + bc->pad;
+	uint16_t *src = (uint16_t *)((uint8_t *)bench_buf + bc->offset);
+	struct display_buffer_descriptor desc = {
+		.width = bc->width,
+		.height = bc->height,
+		.pitch = pitch,
+		.buf_size = ((size_t)pitch * (bc->height - 1U) + bc->width) * sizeof(uint16_t),
+	};
+	struct st7789v_stats stats;
+	uint32_t start;
+	uint32_t us;
+
+	bench_fill(src, (size_t)pitch * bc->height, bc->solid);
+	st7789v_reset_stats(display);
+#ifdef CONFIG_MIPI_DBI_ST7789V_EMUL
+	st7789v_emul_reset_stats(dbi);
+#endif
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_ST7789V_BENCH_ITERATIONS; i++) {
+		/* Alternate between two rows so the window is programmed every time */
+		uint16_t y = (i & 1) ? screen_h - bc->height : 0U;
+		int ret = display_write(display, 0, y, &desc, src);
+
+		if (ret < 0) {
+			printk("Write %ux%u failed (%d)\n", bc->width, bc->height, ret);
+			return;
+		}
+	}
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	st7789v_get_stats(display, &stats);
+
+	printk("%4u x %-3u pad %u off %u %-7s %8u us/call %10llu px/s %5u B/call %3u xfer/call",
+	       bc->width, bc->height, bc->pad, bc->offset, bc->solid ? "solid" : "pattern",
+	       us / CONFIG_ST7789V_BENCH_ITERATIONS,
+	       us > 0U ? stats.pixels * USEC_PER_SEC / us : 0ULL,
+	       (uint32_t)(stats.bytes / CONFIG_ST7789V_BENCH_ITERATIONS),
+	       stats.transfers / CONFIG_ST7789V_BENCH_ITERATIONS);
+
+#ifdef CONFIG_MIPI_DBI_ST7789V_EMUL
+	struct st7789v_emul_stats bus;
+
+	st7789v_emul_get_stats(dbi, &bus);
+	printk(" %3u cmd/call", bus.commands / CONFIG_ST7789V_BENCH_ITERATIONS);
+#endif
+	printk("\n");
+}
+
+int main(void)
+{
+	static const uint16_t widths[] = {1, 16, 60, 120, BENCH_MAX_WIDTH};
+	static const uint16_t heights[] = {1, 16, CONFIG_ST7789V_BENCH_MAX_ROWS};
+	static const uint16_t pads[] = {0, BENCH_PITCH_PAD};
+	static const uint8_t offsets[] = {0, 2};
+	static const struct {
+		uint16_t width;
+		uint16_t height;
+	} areas[] = {
+		{60, 16},
+		{120, CONFIG_ST7789V_BENCH_MAX_ROWS},
+		{BENCH_MAX_PITCH, CONFIG_ST7789V_BENCH_MAX_ROWS},
+	};
+	struct display_capabilities caps;
+	uint32_t mipi_hz = DT_PROP_OR(DT_CHOSEN(zephyr_display), mipi_max_frequency, 0);
+
+	if (!device_is_ready(display)) {
+		printk("Display not ready\n");
+		return 0;
+	}
+
+	display_get_capabilities(display, &caps);
+	display_blanking_off(display);
+
+	printk("ST7789V benchmark: %ux%u, %u Hz bus, %d writes per case\n",
+	       caps.x_resolution, caps.y_resolution, mipi_hz, CONFIG_ST7789V_BENCH_ITERATIONS);
+
+	for (size_t w = 0U; w < ARRAY_SIZE(widths); w++) {
+		for (size_t h = 0U; h < ARRAY_SIZE(heights); h++) {
+			for (size_t p = 0U; p < ARRAY_SIZE(pads); p++) {
+				for (size_t o = 0U; o < ARRAY_SIZE(offsets); o++) {
+					for (int solid = 0; solid <= 1; solid++) {
+						const struct bench_case bc = {
+							.width = MIN(widths[w], caps.x_resolution),
+							.height = MIN(heights[h], caps.y_resolution),
+							.pad = pads[p],
+							.offset = offsets[o],
+							.solid = solid,
+						};
+
+						bench_run(&bc, caps.y_resolution);
+					}
+				}
+			}
+		}
+	}
+
+	/*
+	 * The same widget sized areas as LVGL sends them in partial mode, from
+	 * a buffer of their own, and in direct mode, from a full screen buffer
+	 * with the screen width as pitch.
+	 */
+	printk("Partial vs direct render areas\n");
+
+	for (size_t a = 0U; a < ARRAY_SIZE(areas); a++) {
+		for (int direct = 0; direct <= 1; direct++) {
+			const uint16_t width = MIN(areas[a].width, caps.x_resolution);
+			const struct bench_case bc = {
+				.width = width,
+				.height = MIN(areas[a].height, caps.y_resolution),
+				.pad = direct ? MIN(caps.x_resolution, BENCH_MAX_PITCH) - width : 0U,
+			};
+
+			bench_run(&bc, caps.y_resolution);
+		}
+	}
+
+	printk("ST7789V benchmark done\n");
+
+	return 0;
+}
@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2025 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Drives the ST7789V driver against the emulated controller and checks
+ * what ends up in its frame memory.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include <drivers/display/st7789v.h>
+#include <drivers/mipi_dbi/st7789v_emul.h>
+
+#define TEST_DISPLAY DT_CHOSEN(zephyr_display)
+#define TEST_WIDTH DT_PROP(TEST_DISPLAY, width)
+#define TEST_X_OFFSET DT_PROP(TEST_DISPLAY, x_offset)
+#define TEST_Y_OFFSET DT_PROP(TEST_DISPLAY, y_offset)
+
+#define TEST_MAX_ROWS 20
+#define TEST_BUF_PIXELS (TEST_WIDTH * TEST_MAX_ROWS)
+
+static const struct device *const display = DEVICE_DT_GET(TEST_DISPLAY);
+static const struct device *const dbi = DEVICE_DT_GET(DT_PARENT(TEST_DISPLAY));
+
+static uint16_t test_buf[TEST_BUF_PIXELS];
+
+/* Pixel i of the test pattern, RGB565 in CPU byte order, no two neighbours alike */
+static uint16_t test_color(size_t i)
+{
+	return (uint16_t)(i * 0x0821U + 0x1234U);
+}
+
+/* Pixel as handed to display_write() */
+static uint16_t test_input(uint16_t color)
+{
+	return IS_ENABLED(CONFIG_ST7789V_SWAP_RGB565) ? color : sys_cpu_to_be16(color);
+}
+
+/* Colour the panel stores for an RGB565 pixel */
+static uint16_t test_expected(uint16_t color)
+{
+#ifdef CONFIG_ST7789V_RGB444
+	/* Cut to 4 bits per channel on the bus, widened again by the panel */
+	uint16_t r = color >> 12;
+	uint16_t g = (color >> 7) & 0xfU;
+	uint16_t b = (color >> 1) & 0xfU;
+
+	return (r << 12) | ((r >> 3) << 11) | (g << 7) | ((g >> 2) << 5) | (b << 1) | (b >> 3);
+#else
+	return color;
+#endif
+}
+
+static uint16_t test_gram(uint16_t x, uint16_t y)
+{
+	return st7789v_emul_gram(dbi)[(y + TEST_Y_OFFSET) * ST7789V_EMUL_GRAM_WIDTH +
+				      x + TEST_X_OFFSET];
+}
+
+/* Waits for any write in flight, display_blanking_off() only returns once the bus is idle */
+static void test_sync(void)
+{
+	zassert_ok(display_blanking_off(display));
+}
+
+/* Fill the test buffer with the pattern, padding rows up to pitch */
+static void test_pattern(uint16_t width, uint16_t height, uint16_t pitch)
+{
+	for (size_t row = 0; row < height; row++) {
+		for (size_t col = 0; col < pitch; col++) {
+			test_buf[row * pitch + col] = col < width ?
+				test_input(test_color(row * width + col)) : 0xdeadU;
+		}
+	}
+}
+
+static void test_check(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+	for (uint16_t row = 0; row < height; row++) {
+		for (uint16_t col = 0; col < width; col++) {
+			uint16_t expected = test_expected(test_color(row * width + col));
+
+			zassert_equal(test_gram(x + col, y + row), expected,
+				      "Pixel %u,%u is 0x%04x, expected 0x%04x", x + col, y + row,
+				      test_gram(x + col, y + row), expected);
+		}
+	}
+}
+
+static void test_write(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t pitch)
+{
+	struct display_buffer_descriptor desc = {
+		.width = width,
+		.height = height,
+		.pitch = pitch,
+		.buf_size = ((height - 1) * pitch + width) * sizeof(uint16_t),
+	};
+
+	zassert_true(pitch * height <= TEST_BUF_PIXELS);
+
+	test_pattern(width, height, pitch);
+	zassert_ok(display_write(display, x, y, &desc, test_buf));
+	test_sync();
+}
+
+ZTEST(st7789v, test_write)
+{
+	test_write(10, 5, 16, 8, 16);
+	test_check(10, 5, 16, 8);
+}
+
+ZTEST(st7789v, test_write_strided)
+{
+	test_write(30, 40, 12, 6, 20);
+	test_check(30, 40, 12, 6);
+}
+
+/* Odd widths leave half a pixel pair at the end of each row in RGB444 mode */
+ZTEST(st7789v, test_write_odd)
+{
+	test_write(3, 3, 7, 5, 7);
+	test_check(3, 3, 7, 5);
+
+	test_write(3, 3, 7, 5, 9);
+	test_check(3, 3, 7, 5);
+}
+
+/* Enough rows that a pixel pair spans two bounce buffer batches in RGB444 mode */
+ZTEST(st7789v, test_write_tall_odd)
+{
+	test_write(100, 60, 7, 101, 7);
+	test_check(100, 60, 7, 101);
+}
+
+ZTEST(st7789v, test_write_transfer_cap)
+{
+	struct st7789v_emul_stats bus;
+
+	st7789v_emul_reset_stats(dbi);
+
+	test_write(0, 100, TEST_WIDTH, TEST_MAX_ROWS, TEST_WIDTH);
+	test_check(0, 100, TEST_WIDTH, TEST_MAX_ROWS);
+
+	st7789v_emul_get_stats(dbi, &bus);
+	zassert_true(bus.max_transfer <= CONFIG_ST7789V_MAX_XFER_SIZE,
+		     "Transfer of %u bytes exceeds %u", bus.max_transfer,
+		     CONFIG_ST7789V_MAX_XFER_SIZE);
+}
+
+/* Areas without pixels send nothing, their window end would wrap */
+ZTEST(st7789v, test_write_empty)
+{
+	struct display_buffer_descriptor desc = {
+		.width = 0,
+		.height = 4,
+		.pitch = 8,
+		.buf_size = 0,
+	};
+	struct st7789v_emul_stats bus;
+
+	test_write(60, 60, 8, 4, 8);
+	st7789v_emul_reset_stats(dbi);
+
+	zassert_ok(display_write(display, 60, 60, &desc, test_buf));
+
+	desc.width = 8;
+	desc.height = 0;
+	zassert_ok(display_write(display, 60, 60, &desc, test_buf));
+
+	st7789v_emul_get_stats(dbi, &bus);
+	zassert_equal(bus.commands, 0, "Empty write sent %u commands", bus.commands);
+	zassert_equal(bus.transfers, 0);
+	test_check(60, 60, 8, 4);
+}
+
+ZTEST(st7789v, test_window_cache)
+{
+	struct st7789v_stats stats;
+
+	test_write(50, 50, 8, 8, 8);
+
+	zassert_ok(st7789v_reset_stats(display));
+	test_write(50, 50, 8, 8, 8);
+	test_check(50, 50, 8, 8);
+
+	zassert_ok(st7789v_get_stats(display, &stats));
+	zassert_equal(stats.caset, 0, "Column window sent again");
+	zassert_equal(stats.raset, 0, "Row window sent again");
+
+	test_write(50, 60, 8, 8, 8);
+	zassert_ok(st7789v_get_stats(display, &stats));
+	zassert_equal(stats.caset, 0, "Column window sent for an unchanged column");
+	zassert_equal(stats.raset, 1);
+}
+
+ZTEST(st7789v, test_fill)
+{
+#ifdef CONFIG_ST7789V_FILL
+	struct st7789v_stats stats;
+	uint16_t expected = test_expected(0xf81fU);
+
+	zassert_ok(st7789v_reset_stats(display));
+	zassert_ok(st7789v_fill(display, 20, 30, 13, 7, 0xf81fU));
+	test_sync();
+
+	for (uint16_t y = 30; y < 37; y++) {
+		for (uint16_t x = 20; x < 33; x++) {
+			zassert_equal(test_gram(x, y), expected, "Pixel %u,%u is 0x%04x", x, y,
+				      test_gram(x, y));
+		}
+	}
+
+	zassert_ok(st7789v_get_stats(display, &stats));
+	zassert_equal(stats.fills, 1);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(st7789v, test_partial_area)
+{
+	struct st7789v_emul_state state;
+
+	zassert_ok(st7789v_set_partial_area(display, 10, 20));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_true(state.partial_mode);
+	zassert_equal(state.partial_start, TEST_Y_OFFSET + 10);
+	zassert_equal(state.partial_end, TEST_Y_OFFSET + 29);
+
+	zassert_ok(st7789v_set_partial_area(display, 0, 0));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_false(state.partial_mode);
+}
+
+ZTEST(st7789v, test_scroll_area)
+{
+	struct st7789v_emul_state state;
+
+	zassert_ok(st7789v_set_scroll_area(display, 40, 100));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_equal(state.scroll_top, TEST_Y_OFFSET + 40);
+	zassert_equal(state.scroll_area, 100);
+	zassert_equal(state.scroll_bottom, ST7789V_EMUL_GRAM_HEIGHT - TEST_Y_OFFSET - 140);
+	zassert_equal(state.scroll_start, TEST_Y_OFFSET + 40);
+
+	zassert_ok(st7789v_set_scroll_offset(display, 10));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_equal(state.scroll_start, TEST_Y_OFFSET + 50);
+
+	zassert_ok(st7789v_set_scroll_area(display, 0, 0));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_equal(state.scroll_top, 0);
+	zassert_equal(state.scroll_area, ST7789V_EMUL_GRAM_HEIGHT);
+	zassert_equal(state.scroll_start, 0);
+}
+
+ZTEST(st7789v, test_frame_rate)
+{
+	struct st7789v_emul_state state;
+
+	zassert_equal(st7789v_set_frame_rate(display, 60), 60);
+	st7789v_emul_get_state(dbi, &state);
+	zassert_equal(state.frctrl2, 0x0f);
+}
+
+ZTEST(st7789v, test_suspend)
+{
+	struct display_buffer_descriptor desc = {
+		.width = 8,
+		.height = 4,
+		.pitch = 8,
+		.buf_size = 8 * 4 * sizeof(uint16_t),
+	};
+	struct st7789v_emul_state state;
+	struct st7789v_stats stats;
+
+	test_write(0, 200, 8, 4, 8);
+	zassert_equal(st7789v_set_frame_rate(display, 60), 60);
+
+	zassert_ok(pm_device_action_run(display, PM_DEVICE_ACTION_SUSPEND));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_true(state.sleeping);
+
+	/* Writes are dropped, commands refused, state changes kept for later */
+	zassert_ok(st7789v_reset_stats(display));
+	memset(test_buf, 0, desc.buf_size);
+	zassert_ok(display_write(display, 0, 200, &desc, test_buf));
+	test_check(0, 200, 8, 4);
+	zassert_ok(st7789v_get_stats(display, &stats));
+	zassert_equal(stats.dropped, 1);
+
+	zassert_equal(st7789v_set_idle_mode(display, true), -EBUSY);
+
+	zassert_ok(display_blanking_on(display));
+	zassert_equal(st7789v_set_frame_rate(display, 39), 39);
+	st7789v_emul_get_state(dbi, &state);
+	zassert_true(state.display_on);
+	zassert_equal(state.frctrl2, 0x0f);
+
+	/* The deferred changes go out with the first command after resume */
+	zassert_ok(pm_device_action_run(display, PM_DEVICE_ACTION_RESUME));
+	zassert_ok(st7789v_set_idle_mode(display, false));
+	st7789v_emul_get_state(dbi, &state);
+	zassert_false(state.sleeping);
+	zassert_false(state.display_on);
+	zassert_equal(state.frctrl2, 0x1f);
+
+	test_sync();
+	st7789v_emul_get_state(dbi, &state);
+	zassert_true(state.display_on);
+}
+
+#ifdef CONFIG_ST7789V_TE_SYNC
+#define TEST_TE_PORT DEVICE_DT_GET(DT_GPIO_CTLR(TEST_DISPLAY, te_gpios))
+#define TEST_TE_PIN DT_GPIO_PIN(TEST_DISPLAY, te_gpios)
+#define TEST_TE_DELAY_MS 5
+
+static struct gpio_callback test_te_cb;
+static atomic_t test_te_edges;
+
+/* Counts the TE edges delivered, which only happens while the driver has the interrupt on */
+static void test_te_handler(const struct device *port, struct gpio_callback *cb,
+			    gpio_port_pins_t pins)
+{
+	atomic_inc(&test_te_edges);
+}
+
+/* One TE pulse, as the panel sends it when vertical blanking starts */
+static void test_te_pulse(struct k_timer *timer)
+{
+	gpio_emul_input_set(TEST_TE_PORT, TEST_TE_PIN, 1);
+	gpio_emul_input_set(TEST_TE_PORT, TEST_TE_PIN, 0);
+}
+
+static K_TIMER_DEFINE(test_te_timer, test_te_pulse, NULL);
+
+/* Write one area of a frame, returns how long the write was held in ms */
+static int64_t test_te_write(bool frame_incomplete)
+{
+	struct display_buffer_descriptor desc = {
+		.width = 8,
+		.height = 4,
+		.pitch = 8,
+		.buf_size = 8 * 4 * sizeof(uint16_t),
+		.frame_incomplete = frame_incomplete,
+	};
+	int64_t start = k_uptime_get();
+
+	test_pattern(8, 4, 8);
+	zassert_ok(display_write(display, 80, 80, &desc, test_buf));
+
+	return k_uptime_get() - start;
+}
+
+ZTEST(st7789v, test_te_sync)
+{
+	struct st7789v_emul_state state;
+	int64_t elapsed;
+
+	st7789v_emul_get_state(dbi, &state);
+	zassert_true(state.te_on, "TEON not sent during bring-up");
+	zassert_equal(state.te_mode, 0x00, "TE not limited to V-blank");
+
+	gpio_init_callback(&test_te_cb, test_te_handler, BIT(TEST_TE_PIN));
+	zassert_ok(gpio_add_callback(TEST_TE_PORT, &test_te_cb));
+	atomic_clear(&test_te_edges);
+
+	/* Without a pulse the first write of a frame goes out after the timeout */
+	elapsed = test_te_write(true);
+	zassert_true(elapsed >= CONFIG_ST7789V_TE_TIMEOUT_MS, "Held for %lld ms", elapsed);
+
+	/* Pulses between writes find the interrupt off, the rest of the frame is not held */
+	test_te_pulse(NULL);
+	zassert_equal(atomic_get(&test_te_edges), 0, "TE interrupt left on after the wait");
+	elapsed = test_te_write(false);
+	zassert_true(elapsed < TEST_TE_DELAY_MS, "Held for %lld ms within a frame", elapsed);
+
+	/* The next frame starts on the pulse */
+	k_timer_start(&test_te_timer, K_MSEC(TEST_TE_DELAY_MS), K_NO_WAIT);
+	elapsed = test_te_write(false);
+	zassert_true(elapsed >= TEST_TE_DELAY_MS && elapsed < CONFIG_ST7789V_TE_TIMEOUT_MS,
+		     "Held for %lld ms", elapsed);
+	zassert_equal(atomic_get(&test_te_edges), 1);
+
+	test_te_pulse(NULL);
+	zassert_equal(atomic_get(&test_te_edges), 1, "TE interrupt left on after the wait");
+
+	zassert_ok(gpio_remove_callback(TEST_TE_PORT, &test_te_cb));
+	test_check(80, 80, 8, 4);
+}
+#endif /* CONFIG_ST7789V_TE_SYNC */
+
+#ifdef CONFIG_ST7789V_INDEXED_INPUT
+#define TEST_INDEXED_X 150
+#define TEST_INDEXED_Y 150
+/* Not a multiple of 8, the last byte of each mono row is partly used */
+#define TEST_INDEXED_WIDTH 21
+#define TEST_INDEXED_HEIGHT 6
+#define TEST_INDEXED_STRIDE DIV_ROUND_UP(TEST_INDEXED_WIDTH, 8)
+
+static const uint16_t test_palette[] = {0x001fU, 0xf800U};
+
+static bool test_lit(uint16_t col, uint16_t row)
+{
+	return (row * TEST_INDEXED_WIDTH + col) % 3U == 0U;
+}
+
+/* Write the frame in one input format, the palette maps lit pixels to red */
+static void test_indexed_write(enum display_pixel_format format)
+{
+	uint8_t *buf = (uint8_t *)test_buf;
+	struct display_buffer_descriptor desc = {
+		.width = TEST_INDEXED_WIDTH,
+		.height = TEST_INDEXED_HEIGHT,
+		.pitch = TEST_INDEXED_WIDTH,
+	};
+
+	memset(test_buf, 0, sizeof(test_buf));
+
+	for (uint16_t row = 0; row < TEST_INDEXED_HEIGHT; row++) {
+		for (uint16_t col = 0; col < TEST_INDEXED_WIDTH; col++) {
+			bool lit = test_lit(col, row);
+
+			switch (format) {
+			case PIXEL_FORMAT_MONO01:
+			case PIXEL_FORMAT_MONO10:
+				/* MONO10 sets the bits of dark pixels */
+				if (lit == (format == PIXEL_FORMAT_MONO01)) {
+					buf[row * TEST_INDEXED_STRIDE + col / 8] |= BIT(7 - col % 8);
+				}
+				break;
+			case PIXEL_FORMAT_L_8:
+				buf[row * TEST_INDEXED_WIDTH + col] = lit ? 1U : 0U;
+				break;
+			default:
+				test_buf[row * TEST_INDEXED_WIDTH + col] =
+					test_input(test_palette[lit ? 1 : 0]);
+				break;
+			}
+		}
+	}
+
+	switch (format) {
+	case PIXEL_FORMAT_MONO01:
+	case PIXEL_FORMAT_MONO10:
+		desc.buf_size = TEST_INDEXED_STRIDE * TEST_INDEXED_HEIGHT;
+		break;
+	case PIXEL_FORMAT_L_8:
+		desc.buf_size = TEST_INDEXED_WIDTH * TEST_INDEXED_HEIGHT;
+		break;
+	default:
+		desc.buf_size = TEST_INDEXED_WIDTH * TEST_INDEXED_HEIGHT * sizeof(uint16_t);
+		break;
+	}
+
+	/* Changing the format restores the default palette */
+	zassert_ok(display_set_pixel_format(display, format));
+	if (format != PIXEL_FORMAT_RGB_565) {
+		zassert_ok(st7789v_set_palette(display, test_palette, ARRAY_SIZE(test_palette)));
+	}
+
+	zassert_ok(display_write(display, TEST_INDEXED_X, TEST_INDEXED_Y, &desc, buf));
+	test_sync();
+}
+
+/* Overwrite the frame with green so every format has to draw it again */
+static void test_indexed_clear(void)
+{
+	struct display_buffer_descriptor desc = {
+		.width = TEST_INDEXED_WIDTH,
+		.height = TEST_INDEXED_HEIGHT,
+		.pitch = TEST_INDEXED_WIDTH,
+		.buf_size = TEST_INDEXED_WIDTH * TEST_INDEXED_HEIGHT * sizeof(uint16_t),
+	};
+
+	for (size_t i = 0; i < TEST_INDEXED_WIDTH * TEST_INDEXED_HEIGHT; i++) {
+		test_buf[i] = test_input(0x07e0U);
+	}
+
+	zassert_ok(display_set_pixel_format(display, PIXEL_FORMAT_RGB_565));
+	zassert_ok(display_write(display, TEST_INDEXED_X, TEST_INDEXED_Y, &desc, test_buf));
+	test_sync();
+}
+
+/* The same frame as 1 bit, 8 bit and RGB565 buffers leaves the same frame memory */
+ZTEST(st7789v, test_indexed_input)
+{
+	static const enum display_pixel_format formats[] = {
+		PIXEL_FORMAT_MONO01,
+		PIXEL_FORMAT_MONO10,
+		PIXEL_FORMAT_L_8,
+	};
+	static uint16_t reference[TEST_INDEXED_WIDTH * TEST_INDEXED_HEIGHT];
+
+	test_indexed_clear();
+	test_indexed_write(PIXEL_FORMAT_RGB_565);
+
+	for (uint16_t row = 0; row < TEST_INDEXED_HEIGHT; row++) {
+		for (uint16_t col = 0; col < TEST_INDEXED_WIDTH; col++) {
+			reference[row * TEST_INDEXED_WIDTH + col] =
+				test_gram(TEST_INDEXED_X + col, TEST_INDEXED_Y + row);
+			zassert_equal(reference[row * TEST_INDEXED_WIDTH + col],
+				      test_palette[test_lit(col, row) ? 1 : 0]);
+		}
+	}
+
+	ARRAY_FOR_EACH(formats, i) {
+		test_indexed_clear();
+		test_indexed_write(formats[i]);
+
+		for (uint16_t row = 0; row < TEST_INDEXED_HEIGHT; row++) {
+			for (uint16_t col = 0; col < TEST_INDEXED_WIDTH; col++) {
+				zassert_equal(test_gram(TEST_INDEXED_X + col, TEST_INDEXED_Y + row),
+					      reference[row * TEST_INDEXED_WIDTH + col],
+					      "Format 0x%x differs at %u,%u", formats[i], col, row);
+			}
+		}
+	}
+
+	zassert_ok(display_set_pixel_format(display, PIXEL_FORMAT_RGB_565));
+}
+#endif /* CONFIG_ST7789V_INDEXED_INPUT */
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+#define TEST_HASH_X 120
+#define TEST_HASH_Y 150
+#define TEST_HASH_WIDTH 16
+#define TEST_HASH_HEIGHT 6
+
+/* Write the test buffer as it is, returns the result of display_write() */
+static int test_hash_write(void)
+{
+	struct display_buffer_descriptor desc = {
+		.width = TEST_HASH_WIDTH,
+		.height = TEST_HASH_HEIGHT,
+		.pitch = TEST_HASH_WIDTH,
+		.buf_size = TEST_HASH_WIDTH * TEST_HASH_HEIGHT * sizeof(uint16_t),
+	};
+	int ret;
+
+	ret = display_write(display, TEST_HASH_X, TEST_HASH_Y, &desc, test_buf);
+	test_sync();
+
+	return ret;
+}
+
+static uint64_t test_hash_pixels(void)
+{
+	struct st7789v_emul_stats bus;
+
+	st7789v_emul_get_stats(dbi, &bus);
+
+	return bus.pixels;
+}
+
+ZTEST(st7789v, test_row_hash_repeat)
+{
+	struct st7789v_stats stats;
+
+	test_pattern(TEST_HASH_WIDTH, TEST_HASH_HEIGHT, TEST_HASH_WIDTH);
+	zassert_ok(test_hash_write());
+	zassert_equal(test_hash_pixels(), TEST_HASH_WIDTH * TEST_HASH_HEIGHT);
+
+	st7789v_emul_reset_stats(dbi);
+	zassert_ok(st7789v_reset_stats(display));
+	zassert_ok(test_hash_write());
+
+	zassert_equal(test_hash_pixels(), 0, "Unchanged area sent again");
+	zassert_ok(st7789v_get_stats(display, &stats));
+	zassert_equal(stats.rows_skipped, TEST_HASH_HEIGHT);
+	test_check(TEST_HASH_X, TEST_HASH_Y, TEST_HASH_WIDTH, TEST_HASH_HEIGHT);
+}
+
+ZTEST(st7789v, test_row_hash_one_pixel)
+{
+	const size_t changed = 3 * TEST_HASH_WIDTH + 5;
+
+	test_pattern(TEST_HASH_WIDTH, TEST_HASH_HEIGHT, TEST_HASH_WIDTH);
+	zassert_ok(test_hash_write());
+
+	st7789v_emul_reset_stats(dbi);
+	test_buf[changed] = test_input(0xf800U);
+	zassert_ok(test_hash_write());
+
+	zassert_equal(test_hash_pixels(), TEST_HASH_WIDTH, "Sent more than the changed row");
+	zassert_equal(test_gram(TEST_HASH_X + 5, TEST_HASH_Y + 3), test_expected(0xf800U));
+	zassert_equal(test_gram(TEST_HASH_X + 4, TEST_HASH_Y + 3),
+		      test_expected(test_color(changed - 1)));
+}
+
+/* Rows of a failed write may or may not have reached the panel, a retry sends them all */
+ZTEST(st7789v, test_row_hash_failure)
+{
+	test_pattern(TEST_HASH_WIDTH, TEST_HASH_HEIGHT, TEST_HASH_WIDTH);
+	zassert_ok(test_hash_write());
+
+	for (size_t i = 0; i < TEST_HASH_WIDTH * TEST_HASH_HEIGHT; i++) {
+		test_buf[i] = test_input(test_color(i) ^ 0xffffU);
+	}
+
+	st7789v_emul_fail_next(dbi, -EIO);
+	zassert_equal(test_hash_write(), -EIO);
+
+	st7789v_emul_reset_stats(dbi);
+	zassert_ok(test_hash_write());
+	zassert_equal(test_hash_pixels(), TEST_HASH_WIDTH * TEST_HASH_HEIGHT,
+		      "Retry skipped rows of the failed write");
+
+	for (uint16_t row = 0; row < TEST_HASH_HEIGHT; row++) {
+		for (uint16_t col = 0; col < TEST_HASH_WIDTH; col++) {
+			zassert_equal(test_gram(TEST_HASH_X + col, TEST_HASH_Y + row),
+				      test_expected(test_color(row * TEST_HASH_WIDTH + col) ^
+						    0xffffU));
+		}
+	}
+}
+#endif /* CONFIG_ST7789V_ROW_HASH */
+
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+/* Results of the API calls made from the system work queue during the bring-up */
+static int early_idle_ret;
+static int early_blanking_ret;
+static bool early_display_on;
+
+static void test_early_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	early_idle_ret = st7789v_set_idle_mode(display, false);
+	early_blanking_ret = display_blanking_off(display);
+}
+
+static K_WORK_DEFINE(test_early_work, test_early_handler);
+
+/* Runs before the bring-up has left the reset and sleep-out delays */
+static int test_early_init(void)
+{
+	k_work_submit(&test_early_work);
+
+	return 0;
+}
+
+SYS_INIT(test_early_init, APPLICATION, 99);
+
+ZTEST(st7789v, test_early_blanking)
+{
+	zassert_equal(early_idle_ret, -EWOULDBLOCK, "Bring-up already done (%d)", early_idle_ret);
+	zassert_ok(early_blanking_ret);
+	zassert_true(early_display_on, "Display still off after the bring-up");
+}
+#endif /* CONFIG_ST7789V_DEFERRED_INIT */
+
+static void *st7789v_setup(void)
+{
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	struct st7789v_emul_state state;
+#endif
+
+	zassert_true(device_is_ready(display), "Display not ready");
+#ifdef CONFIG_ST7789V_DEFERRED_INIT
+	/* Waits for the bring-up without touching the blanking */
+	zassert_ok(st7789v_set_idle_mode(display, false));
+	st7789v_emul_get_state(dbi, &state);
+	early_display_on = state.display_on;
+#endif
+	test_sync();
+
+	return NULL;
+}
+
+static void st7789v_before(void *fixture)
+{
+#ifdef CONFIG_ST7789V_ROW_HASH
+	struct display_capabilities caps;
+#endif
+
+	ARG_UNUSED(fixture);
+
+#ifdef CONFIG_ST7789V_ROW_HASH
+	/* Setting the orientation forgets the row hashes, tests repeat each other's writes */
+	display_get_capabilities(display, &caps);
+	zassert_ok(display_set_orientation(display, caps.current_orientation));
+#endif
+	zassert_ok(st7789v_reset_stats(display));
+	st7789v_emul_reset_stats(dbi);
+}
+
+ZTEST_SUITE(st7789v, NULL, st7789v_setup, st7789v_before, NULL, NULL);